@@ -63,6 +63,18 @@ typedef struct tagFlsEmu_SystemMemoryType {
     DWORD allocationGranularity;
 } FlsEmu_SystemMemoryType;
 
+#if (STANDALONE_DLL != 1) && (XCP_ENABLE_BUILD_CHECKSUM == XCP_ON)
+/** @brief Read-only view used to checksum a part of a segment.
+ *
+ *
+ */
+typedef struct tagFlsEmu_WindowType {
+    void * view;
+    uint8_t const * data;
+    uint32_t length;
+} FlsEmu_WindowType;
+#endif // XCP_ENABLE_BUILD_CHECKSUM
+
 /*
 **  Local Function Prototypes.
 */
@@ -79,6 +91,11 @@ static DWORD GetAllocationGranularity(void);
 static void MemoryInfo(void * address);
 static HANDLE OpenCreateFile(char const * fileName, bool create);
 static bool CreateFileView(HANDLE handle, DWORD length, Xcp_HwFileViewType * fileView);
+#if (STANDALONE_DLL != 1) && (XCP_ENABLE_BUILD_CHECKSUM == XCP_ON)
+static uint32_t FlsEmu_WindowSize(FlsEmu_SegmentType const * segment);
+static bool FlsEmu_MapWindow(FlsEmu_SegmentType const * segment, uint32_t offset, uint32_t length, FlsEmu_WindowType * window);
+static void FlsEmu_UnmapWindow(FlsEmu_WindowType const * window);
+#endif // XCP_ENABLE_BUILD_CHECKSUM
 /*
 **  Local Variables.
 */
@@ -327,6 +344,167 @@ void FlsEmu_EraseBlock(uint8_t segmentIdx, uint16_t block)
 }
 
 
+/** @brief Map a page of a segment as private, copy-on-write memory.
+ *
+ *  Mapping is instant regardless of the page size: the memory manager
+ *  duplicates pages of the view on their first write only, and writes never
+ *  reach the file. Resetting a working page to its reference (COPY_CAL_PAGE,
+ *  s. Xcp_HookFunction_CopyCalPage()) therefore needs no copy.
+ *
+ * @param segmentIdx
+ * @param page Page of the segment used as source.
+ * @param copy Copies made so far; the previous one is retired, the one before unmapped.
+ * @return Pointer to the copy of the page, NULL on errors.
+ *
+ */
+void * FlsEmu_CopyOnWrite(uint8_t segmentIdx, uint8_t page, FlsEmu_CopyOnWriteType * copy)
+{
+    FlsEmu_SegmentType const * segment;
+    uint32_t offset;
+    uint32_t viewOffset;
+    void * view;
+
+    FLSEMU_ASSERT_INITIALIZED();
+    if (!VALIDATE_SEGMENT_IDX(segmentIdx)) {
+        return NULL;
+    }
+    segment = FlsEmu_Config->segments[segmentIdx];
+    offset = segment->pageSize * page;
+    if ((offset >= segment->memSize) || (segment->pageSize > (segment->memSize - offset))) {
+        return NULL;
+    }
+    viewOffset = offset - (offset % (uint32_t)FlsEmu_SystemMemory.allocationGranularity);
+    view = (void *)MapViewOfFile(segment->persistentArray->mappingHandle, FILE_MAP_COPY, 0, viewOffset, segment->pageSize + (offset - viewOffset));
+    if (view == NULL) {
+        Win_ErrorMsg("FlsEmu_CopyOnWrite::MapViewOfFile()", GetLastError());
+        return NULL;
+    }
+    if (copy->retired != NULL) {
+        UnmapViewOfFile(copy->retired);
+    }
+    copy->retired = copy->view;
+    copy->view = view;
+    return (uint8_t *)view + (offset - viewOffset);
+}
+
+/** @brief Unmap all copies made by FlsEmu_CopyOnWrite().
+ *
+ * @param copy
+ *
+ */
+void FlsEmu_ReleaseCopyOnWrite(FlsEmu_CopyOnWriteType * copy)
+{
+    if (copy->retired != NULL) {
+        UnmapViewOfFile(copy->retired);
+        copy->retired = NULL;
+    }
+    if (copy->view != NULL) {
+        UnmapViewOfFile(copy->view);
+        copy->view = NULL;
+    }
+}
+
+
+#if (STANDALONE_DLL != 1) && (XCP_ENABLE_BUILD_CHECKSUM == XCP_ON)
+/** @brief Checksum over a range of a segment.
+ *
+ *  The range is not accessed through the page view (s. FlsEmu_SelectPage()),
+ *  but walked in windows of at least one page, each mapped read-only on its own.
+ *  The next window is mapped and prefetched while the current one is checksummed,
+ *  consumed windows are dropped from the working set and unmapped, so large
+ *  segments are neither faulted in page by page nor kept resident.
+ *
+ * @param segmentIdx
+ * @param offset Offset into the segment.
+ * @param length Number of bytes.
+ * @param result Checksum, as calculated by Xcp_CalculateChecksum() over the whole range.
+ * @return TRUE if successful otherwise FALSE.
+ *
+ */
+bool FlsEmu_Checksum(uint8_t segmentIdx, uint32_t offset, uint32_t length, Xcp_ChecksumType * result)
+{
+    FlsEmu_SegmentType const * segment;
+    FlsEmu_WindowType current;
+    FlsEmu_WindowType next;
+    Xcp_ChecksumType checksum = (Xcp_ChecksumType)0;
+    uint32_t windowSize;
+    uint8_t const dummy = UINT8(0);
+    bool isFirstCall = TRUE;
+    bool hasNext;
+
+    FLSEMU_ASSERT_INITIALIZED();
+    if (!VALIDATE_SEGMENT_IDX(segmentIdx)) {
+        return FALSE;
+    }
+    segment = FlsEmu_Config->segments[segmentIdx];
+    if ((offset > segment->memSize) || (length > (segment->memSize - offset))) {
+        return FALSE;
+    }
+    if (length == 0UL) {
+        *result = Xcp_CalculateChecksum(&dummy, 0UL, (Xcp_ChecksumType)0, TRUE);
+        return TRUE;
+    }
+    windowSize = FlsEmu_WindowSize(segment);
+    if (!FlsEmu_MapWindow(segment, offset, XCP_MIN(length, windowSize), &current)) {
+        return FALSE;
+    }
+    do {
+        offset += current.length;
+        length -= current.length;
+        hasNext = (length > 0UL);
+        if (hasNext) {
+            if (!FlsEmu_MapWindow(segment, offset, XCP_MIN(length, windowSize), &next)) {
+                FlsEmu_UnmapWindow(&current);
+                return FALSE;
+            }
+        }
+        /* Windows are multiples of 64KB, so the calculation can be continued across them. */
+        checksum = Xcp_CalculateChecksum(current.data, current.length, checksum, isFirstCall);
+        isFirstCall = FALSE;
+        FlsEmu_UnmapWindow(&current);
+        if (hasNext) {
+            current = next;
+        }
+    } while (hasNext);
+    *result = checksum;
+    return TRUE;
+}
+
+/** @brief Checksum over a range of the XCP address space.
+ *
+ *  Intended to be called from Xcp_HookFunction_BuildChecksum().
+ *
+ *  Like UPLOAD and DOWNLOAD, the address refers to the currently selected page
+ *  (s. FlsEmu_SelectPage()).
+ *
+ * @param address Start address, must lie in a segment (s. FlsEmu_SegmentType::baseAddress).
+ * @param length Number of bytes, the range must not cross the end of the page.
+ * @param result
+ * @return TRUE if the range is emulated flash and the checksum could be calculated.
+ *
+ */
+bool FlsEmu_ChecksumAddress(uint32_t address, uint32_t length, Xcp_ChecksumType * result)
+{
+    uint8_t idx;
+    uint32_t offset;
+    FlsEmu_SegmentType const * segment;
+
+    FLSEMU_ASSERT_INITIALIZED();
+    for (idx = 0; idx < FlsEmu_Config->numSegments; ++idx) {
+        segment = FlsEmu_Config->segments[idx];
+        if ((address >= segment->baseAddress) && ((address - segment->baseAddress) < segment->pageSize)) {
+            offset = address - segment->baseAddress;
+            if (length > (segment->pageSize - offset)) {
+                return FALSE;
+            }
+            return FlsEmu_Checksum(idx, (segment->pageSize * segment->currentPage) + offset, length, result);
+        }
+    }
+    return FALSE;
+}
+#endif // XCP_ENABLE_BUILD_CHECKSUM
+
+
 #if 0
 bool XcpOw_MapFileOpen(char const * fname, Xcp_HwMapFileType * mf)
 {
@@ -381,6 +559,50 @@ static bool FlsEmu_MapView(FlsEmu_SegmentType * config, uint32_t offset, uint32_
     return TRUE;
 }
 
+#if (STANDALONE_DLL != 1) && (XCP_ENABLE_BUILD_CHECKSUM == XCP_ON)
+/*
+**  One page, but at least the allocation granularity (views have to start on
+**  multiples of it).
+*/
+static uint32_t FlsEmu_WindowSize(FlsEmu_SegmentType const * segment)
+{
+    uint32_t const granularity = (uint32_t)FlsEmu_SystemMemory.allocationGranularity;
+
+    return ((segment->pageSize + granularity - 1UL) / granularity) * granularity;
+}
+
+static bool FlsEmu_MapWindow(FlsEmu_SegmentType const * segment, uint32_t offset, uint32_t length, FlsEmu_WindowType * window)
+{
+    uint32_t const viewOffset = offset - (offset % (uint32_t)FlsEmu_SystemMemory.allocationGranularity);
+    uint32_t const viewLength = length + (offset - viewOffset);
+#if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0602)
+    WIN32_MEMORY_RANGE_ENTRY range;
+#endif
+
+    window->view = (void *)MapViewOfFile(segment->persistentArray->mappingHandle, FILE_MAP_READ, 0, viewOffset, viewLength);
+    if (window->view == NULL) {
+        Win_ErrorMsg("FlsEmu_MapWindow::MapViewOfFile()", GetLastError());
+        return FALSE;
+    }
+    window->data = (uint8_t const *)window->view + (offset - viewOffset);
+    window->length = length;
+#if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0602)
+    /* Windows 8+: read the window ahead with large I/Os, instead of faulting it in page by page. */
+    range.VirtualAddress = window->view;
+    range.NumberOfBytes = (SIZE_T)viewLength;
+    (void)PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+    return TRUE;
+}
+
+static void FlsEmu_UnmapWindow(FlsEmu_WindowType const * window)
+{
+    /* Unlocking pages that are not locked removes them from the working set. */
+    (void)VirtualUnlock(window->view, (SIZE_T)((window->data - (uint8_t const *)window->view) + window->length));
+    UnmapViewOfFile(window->view);
+}
+#endif // XCP_ENABLE_BUILD_CHECKSUM
+
 static FlsEmu_OpenCreateResultType FlsEmu_OpenCreatePersitentArray(char const * fileName, DWORD size, PersistentArrayType * persistentArray)
 {
     DWORD error;
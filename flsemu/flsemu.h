@@ -100,6 +100,17 @@ typedef struct tagFlsEmu_ConfigType {
     FlsEmu_SegmentType /*const*/ ** segments;
 } FlsEmu_ConfigType;
 
+
+/** @brief Private copy of a page, s. FlsEmu_CopyOnWrite().
+ *
+ *  The previous copy stays mapped until the next call, so readers that
+ *  still hold a pointer into it are not pulled from under.
+ */
+typedef struct tagFlsEmu_CopyOnWriteType {
+    void * view;
+    void * retired;
+} FlsEmu_CopyOnWriteType;
+
 /*
 **  Global Functions.
 */
@@ -110,5 +121,11 @@ void FlsEmu_SelectPage(uint8_t segmentIdx, uint8_t page);
 void FlsEmu_ErasePage(uint8_t segmentIdx, uint8_t page);
 void FlsEmu_EraseSector(uint8_t segmentIdx, uint32_t address);
 void FlsEmu_EraseBlock(uint8_t segmentIdx, uint16_t block);
+void * FlsEmu_CopyOnWrite(uint8_t segmentIdx, uint8_t page, FlsEmu_CopyOnWriteType * copy);
+void FlsEmu_ReleaseCopyOnWrite(FlsEmu_CopyOnWriteType * copy);
+#if (STANDALONE_DLL != 1) && (XCP_ENABLE_BUILD_CHECKSUM == XCP_ON)
+bool FlsEmu_Checksum(uint8_t segmentIdx, uint32_t offset, uint32_t length, Xcp_ChecksumType * result);
+bool FlsEmu_ChecksumAddress(uint32_t address, uint32_t length, Xcp_ChecksumType * result);
+#endif // XCP_ENABLE_BUILD_CHECKSUM
 
 #endif // __FLSEMU_H
@@ -75,6 +75,60 @@ extern "C"
     #error XCP_DAQ_MAX_EVENT_CHANNEL must be at least 1
 #endif // XCP_DAQ_MAX_EVENT_CHANNEL
 
+#if (XCP_ENABLE_DAQ_COMMANDS == XCP_ON) && (XCP_DAQ_QUEUE_SIZE < 1)
+    #error XCP_DAQ_QUEUE_SIZE must be at least 1
+#endif // XCP_DAQ_QUEUE_SIZE
+
+#if (XCP_ENABLE_DAQ_COMMANDS == XCP_ON) && ((XCP_DAQ_PLAN_CACHE_SIZE < 1) || (XCP_DAQ_PLAN_CACHE_SIZE > 255))
+    #error XCP_DAQ_PLAN_CACHE_SIZE must be in range [1..255]
+#endif // XCP_DAQ_PLAN_CACHE_SIZE
+
+#if (XCP_CHECKSUM_INDEX_REGIONS > 0) && \
+    (((XCP_CHECKSUM_INDEX_BLOCK_SIZE % 64) != 0) || (XCP_CHECKSUM_INDEX_BLOCKS < 1) || (XCP_CHECKSUM_INDEX_BLOCKS > 65535))
+    #error XCP_CHECKSUM_INDEX_BLOCK_SIZE must be a multiple of 64, XCP_CHECKSUM_INDEX_BLOCKS in range [1..65535]
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+
+#if XCP_CHECKSUM_WORKER_THREAD == XCP_ON
+#if !defined(__linux__)
+    #error XCP_CHECKSUM_WORKER_THREAD requires a Linux host
+#endif // __linux__
+#if XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_OFF
+    #error XCP_CHECKSUM_WORKER_THREAD requires XCP_CHECKSUM_CHUNKED_CALCULATION
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+#if (XCP_CHECKSUM_WORKER_THREADS < 1) || (XCP_CHECKSUM_WORKER_THREADS > 64)
+    #error XCP_CHECKSUM_WORKER_THREADS must be in range [1..64]
+#endif // XCP_CHECKSUM_WORKER_THREADS
+#endif // XCP_CHECKSUM_WORKER_THREAD
+
+#if (XCP_ENABLE_MASTER_BLOCKMODE == XCP_ON) && ((XCP_ENABLE_DOWNLOAD_NEXT == XCP_OFF) || (XCP_MAX_BS < 1) || (XCP_MAX_BS > 255))
+    #error XCP_ENABLE_MASTER_BLOCKMODE requires XCP_ENABLE_DOWNLOAD_NEXT and XCP_MAX_BS in range [1..255]
+#endif // XCP_ENABLE_MASTER_BLOCKMODE
+#if (XCP_ENABLE_DOWNLOAD_NEXT == XCP_ON) && (XCP_ENABLE_MASTER_BLOCKMODE == XCP_OFF)
+    #error XCP_ENABLE_DOWNLOAD_NEXT requires XCP_ENABLE_MASTER_BLOCKMODE
+#endif // XCP_ENABLE_DOWNLOAD_NEXT
+
+#if (XCP_CAL_STAGING_SIZE < 0) || (XCP_CAL_STAGING_SIZE > 65535)
+    #error XCP_CAL_STAGING_SIZE must be in range [0..65535]
+#endif // XCP_CAL_STAGING_SIZE
+#if (XCP_CAL_STAGING_SIZE > 0) && ((XCP_ENABLE_CAL_COMMANDS == XCP_OFF) || (XCP_ENABLE_USER_CMD == XCP_OFF))
+    #error Calibration transactions (XCP_CAL_STAGING_SIZE) require XCP_ENABLE_CAL_COMMANDS and XCP_ENABLE_USER_CMD
+#endif // XCP_CAL_STAGING_SIZE
+#if (XCP_CAL_STAGING_SIZE > 0) && (XCP_CAL_COMMIT_ON_EVENT == XCP_ON) && (XCP_ENABLE_DAQ_COMMANDS == XCP_OFF)
+    #error XCP_CAL_COMMIT_ON_EVENT requires XCP_ENABLE_DAQ_COMMANDS (commits are applied by XcpDaq_TriggerEvent())
+#endif // XCP_CAL_COMMIT_ON_EVENT
+
+#if (XCP_ENABLE_PAG_COMMANDS == XCP_ON) && ((XCP_PAG_SEGMENTS < 1) || (XCP_PAG_SEGMENTS > 255))
+    #error XCP_PAG_SEGMENTS must be in range [1..255]
+#endif // XCP_ENABLE_PAG_COMMANDS
+
+#if (XCP_MEMORY_REGIONS < 0) || (XCP_MEMORY_REGIONS > 65535)
+    #error XCP_MEMORY_REGIONS must be in range [0..65535]
+#endif // XCP_MEMORY_REGIONS
+
+#if (XCP_ENABLE_ADDRESS_MAPPER == XCP_ON) && ((XCP_ADDRESS_MAPPER_ENTRIES < 1) || (XCP_ADDRESS_MAPPER_ENTRIES > 255))
+    #error XCP_ADDRESS_MAPPER_ENTRIES must be in range [1..255]
+#endif // XCP_ADDRESS_MAPPER_ENTRIES
+
 #if XCP_ENFORCE_CAN_RESTRICTIONS == XCP_ON
 #if XCP_MAX_CTO != 8
 #error XCP_MAX_CTO must be set to 8
@@ -297,6 +351,21 @@ typedef struct tagXcp_MtaType {
     uint32_t address;
 } Xcp_MtaType;
 
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+/* Address extension of slave internal objects, e.g. the station ID uploaded after GET_ID. */
+#define XCP_ADDRESS_EXT_INTERNAL    UINT8(0xff)
+
+/*
+** [ext:address, ext:address + length) --> [host, host + length)
+*/
+typedef struct tagXcp_AddressMappingType {
+    uint8_t ext;
+    uint32_t address;
+    uint32_t length;
+    uint8_t * host;
+} Xcp_AddressMappingType;
+#endif // XCP_ENABLE_ADDRESS_MAPPER
+
 #if XCP_ENABLE_DAQ_COMMANDS == XCP_ON
 typedef struct tagXcpDaq_MtaType {
 #if XCP_DAQ_ADDR_EXT_SUPPORTED == XCP_ON
@@ -380,6 +449,7 @@ typedef struct tagXcpDaq_ODTEntryType {
 #if XCP_DAQ_BIT_OFFSET_SUPPORTED == XCP_ON
     uint8_t bitOffset;
 #endif // XCP_DAQ_BIT_OFFSET_SUPPORTED
+    uint8_t epoch;      /* Entry is only valid while this matches the epoch of its list. */
     uint32_t length;
 } XcpDaq_ODTEntryType;
 
@@ -400,6 +470,9 @@ typedef struct tagXcpDaq_ListType {
     XcpDaq_ODTIntegerType numOdts;
     uint16_t firstOdt;
     uint8_t mode;
+    uint8_t epoch;
+    uint16_t eventChannel;
+    uint8_t priority;
 #if XCP_DAQ_PRESCALER_SUPPORTED == XCP_ON
     uint8_t prescaler;
     uint8_t  counter;
@@ -443,7 +516,59 @@ typedef enum tagXcp_MemoryAccessType {
     XCP_MEM_ACCESS_READ,
     XCP_MEM_ACCESS_WRITE,
 } Xcp_MemoryAccessType;
-
+
+#if XCP_MEMORY_REGIONS > 0
+#define XCP_MEMORY_REGION_READ      UINT8(0x01)
+#define XCP_MEMORY_REGION_WRITE     UINT8(0x02)
+#define XCP_MEMORY_REGION_PROGRAM   UINT8(0x04) /* Writable while programming. */
+#define XCP_MEMORY_REGION_DEVICE    UINT8(0x08) /* Device memory, accessed bytewise and exactly once. */
+
+/*
+** [ext:address, ext:address + length), s. Xcp_MemoryRegions[].
+*/
+typedef struct tagXcp_MemoryRegionType {
+    uint8_t ext;
+    uint32_t address;
+    uint32_t length;
+    uint8_t access;
+} Xcp_MemoryRegionType;
+#endif // XCP_MEMORY_REGIONS
+
+#if XCP_ENABLE_PAG_COMMANDS == XCP_ON
+/* SET_CAL_PAGE / GET_CAL_PAGE mode. */
+#define XCP_PAG_MODE_ECU                        UINT8(0x01)
+#define XCP_PAG_MODE_XCP                        UINT8(0x02)
+#define XCP_PAG_MODE_ALL                        UINT8(0x80)
+
+#define XCP_PAG_SEGMENT_MODE_FREEZE             UINT8(0x01)
+
+/* PAGE_PROPERTIES (GET_PAGE_INFO). */
+#define XCP_PAG_ECU_ACCESS_WITHOUT_XCP          UINT8(0x01)
+#define XCP_PAG_ECU_ACCESS_WITH_XCP             UINT8(0x02)
+#define XCP_PAG_XCP_READ_ACCESS_WITHOUT_ECU     UINT8(0x04)
+#define XCP_PAG_XCP_READ_ACCESS_WITH_ECU        UINT8(0x08)
+#define XCP_PAG_XCP_WRITE_ACCESS_WITHOUT_ECU    UINT8(0x10)
+#define XCP_PAG_XCP_WRITE_ACCESS_WITH_ECU       UINT8(0x20)
+
+typedef struct tagXcp_PagPageType {
+    uint8_t * data;         /* Host memory holding the page. */
+    uint8_t properties;
+} Xcp_PagPageType;
+
+/*
+** [ext:address, ext:address + length) is backed by one of `pageCount` pages,
+** page 0 is active after Xcp_Init(). `pages` is writable, because
+** Xcp_HookFunction_CopyCalPage() may move a page to new host memory.
+*/
+typedef struct tagXcp_PagSegmentType {
+    uint8_t ext;
+    uint32_t address;
+    uint32_t length;
+    uint8_t pageCount;
+    Xcp_PagPageType * pages;
+} Xcp_PagSegmentType;
+#endif // XCP_ENABLE_PAG_COMMANDS
+
 typedef void(*Xcp_SendCalloutType)(Xcp_PDUType const * pdu);
 typedef void (*Xcp_ServerCommandType)(Xcp_PDUType const * const pdu);
 
@@ -469,7 +594,14 @@ Xcp_MtaType Xcp_GetNonPagedAddress(void const * const ptr);
 void Xcp_SetMta(Xcp_MtaType mta);
 void Xcp_SetBusy(bool enable);
 bool Xcp_IsBusy(void);
-Xcp_StateType const * Xcp_GetState(void);
+Xcp_StateType const * Xcp_GetState(void);
+bool Xcp_CheckMemoryAccess(Xcp_MtaType mta, uint32_t length, Xcp_MemoryAccessType access, bool programming);
+bool Xcp_IsDeviceMemory(Xcp_MtaType mta);
+uint8_t * Xcp_MapAddress(Xcp_MtaType mta, uint32_t length);
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+bool Xcp_AddressMapperRegister(uint8_t ext, uint32_t address, uint32_t length, void * host);
+void Xcp_AddressMapperClear(void);
+#endif // XCP_ENABLE_ADDRESS_MAPPER
 
 
 /*
@@ -486,17 +618,63 @@ XcpDaq_ODTEntryType * XcpDaq_GetOdtEntry(XcpDaq_ListIntegerType daqListNumber, X
 bool XcpDaq_ValidateConfiguration(void);
 bool XcpDaq_ValidateList(XcpDaq_ListIntegerType daqListNumber);
 bool XcpDaq_ValidateOdtEntry(XcpDaq_ListIntegerType daqListNumber, XcpDaq_ODTIntegerType odtNumber, XcpDaq_ODTEntryIntegerType odtEntry);
-void XcpDaq_MainFunction(void);
+uint16_t XcpDaq_MainFunction(void);
 void XcpDaq_AddEventChannel(XcpDaq_ListIntegerType daqListNumber, uint16_t eventChannelNumber);
 void XcpDaq_TriggerEvent(uint8_t eventChannelNumber);
 void XcpDaq_GetProperties(uint8_t * properties);
 XcpDaq_ListIntegerType XcpDaq_GetListCount(void);
 void XcpDaq_SetProcessorState(XcpDaq_ProcessorStateType state);
-void XcpDaq_StartSelectedLists(void);
+uint8_t XcpDaq_GetFirstPid(XcpDaq_ListIntegerType daqListNumber);
+Xcp_ReturnType XcpDaq_StartList(XcpDaq_ListIntegerType daqListNumber);
+void XcpDaq_StopList(XcpDaq_ListIntegerType daqListNumber);
+void XcpDaq_ClearList(XcpDaq_ListIntegerType daqListNumber);
+Xcp_ReturnType XcpDaq_StartSelectedLists(void);
 void XcpDaq_StopSelectedLists(void);
-void XcpDaq_StopAllLists(void);
+void XcpDaq_StopAllLists(void);
+void XcpDaq_CompileGatherPlan(void);
+void XcpDaq_InvalidateGatherPlan(void);
+void XcpDaq_FlushGatherPlans(void);
+void XcpDaq_AddToFingerprint(uint8_t const * data, uint16_t length);
+uint32_t XcpDaq_GetFingerprint(void);
+#if XCP_ENABLE_STIM == XCP_ON
+void XcpDaq_StimReceive(Xcp_PDUType const * const pdu);
+#endif // XCP_ENABLE_STIM
 #endif // XCP_ENABLE_DAQ_COMMANDS
 
+/*
+** Calibration Transactions.
+*/
+#if XCP_CAL_STAGING_SIZE > 0
+/* USER_CMD sub-commands. */
+#define XCP_USER_CMD_CAL_BEGIN      UINT8(0x01)
+#define XCP_USER_CMD_CAL_COMMIT     UINT8(0x02)
+#define XCP_USER_CMD_CAL_ABORT      UINT8(0x03)
+
+void XcpCal_Init(void);
+Xcp_ReturnType XcpCal_Begin(void);
+Xcp_ReturnType XcpCal_Commit(void);
+void XcpCal_Abort(void);
+bool XcpCal_IsStaging(void);
+bool XcpCal_IsPending(void);
+Xcp_ReturnType XcpCal_Stage(uint8_t * dst, uint8_t const * src, uint32_t length, bool device);
+void XcpCal_TriggerEvent(uint8_t eventChannelNumber);
+#endif // XCP_CAL_STAGING_SIZE
+
+/*
+** PAG Implementation Functions.
+*/
+#if XCP_ENABLE_PAG_COMMANDS == XCP_ON
+void XcpPag_Init(void);
+Xcp_ReturnType XcpPag_SetCalPage(uint8_t segment, uint8_t page, uint8_t mode);
+Xcp_ReturnType XcpPag_GetCalPage(uint8_t segment, uint8_t mode, uint8_t * page);
+Xcp_ReturnType XcpPag_SetSegmentMode(uint8_t segment, uint8_t mode);
+Xcp_ReturnType XcpPag_GetSegmentMode(uint8_t segment, uint8_t * mode);
+Xcp_ReturnType XcpPag_CopyCalPage(uint8_t srcSegment, uint8_t srcPage, uint8_t dstSegment, uint8_t dstPage);
+uint8_t * XcpPag_GetEcuPage(uint8_t segment);
+uint8_t * const * XcpPag_GetEcuPageTable(void);
+uint8_t * XcpPag_MapAddress(Xcp_MtaType mta, uint32_t length);
+#endif // XCP_ENABLE_PAG_COMMANDS
+
 #define XCP_CHECKSUM_METHOD_XCP_ADD_11      (1)
 #define XCP_CHECKSUM_METHOD_XCP_ADD_12      (2)
 #define XCP_CHECKSUM_METHOD_XCP_ADD_14      (3)
@@ -506,6 +684,14 @@ void XcpDaq_StopAllLists(void);
 #define XCP_CHECKSUM_METHOD_XCP_CRC_16      (7)
 #define XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT (8)
 #define XCP_CHECKSUM_METHOD_XCP_CRC_32      (9)
+#define XCP_CHECKSUM_METHOD_XCP_USER_DEFINED    (0xFF)
+
+/* XCP_CHECKSUM_METHOD_XCP_USER_DEFINED maps to bit 31. */
+#define XCP_CHECKSUM_METHOD_MASK(method)    (1ul << ((method) & 0x1f))
+
+/* The configured method is the default, s. Xcp_SetChecksumMethod(). */
+#define XCP_CHECKSUM_METHODS_AVAILABLE          (XCP_CHECKSUM_METHODS | XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD))
+#define XCP_CHECKSUM_METHOD_AVAILABLE(method)   ((XCP_CHECKSUM_METHODS_AVAILABLE & XCP_CHECKSUM_METHOD_MASK(method)) != 0)
 
 #define XCP_DAQ_TIMESTAMP_UNIT_1NS          (0)
 #define XCP_DAQ_TIMESTAMP_UNIT_10NS         (1)
@@ -529,6 +715,7 @@ void XcpDaq_StopAllLists(void);
 **
 */
 void Xcp_SendPdu(void);
+void Xcp_SendDto(uint8_t * frame, uint16_t len);
 uint8_t * Xcp_GetOutPduPtr(void);
 void Xcp_SetPduOutLen(uint16_t len);
 void Xcp_Send8(uint8_t len, uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5, uint8_t b6, uint8_t b7);
@@ -536,7 +723,7 @@ void Xcp_Send8(uint8_t len, uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint
 /*
 **  Helpers.
 */
-void Xcp_CopyMemory(Xcp_MtaType dst, Xcp_MtaType src, uint32_t len);
+Xcp_ReturnType Xcp_CopyMemory(Xcp_MtaType dst, Xcp_MtaType src, uint32_t len);
 
 uint8_t Xcp_GetByte(Xcp_PDUType const * const value, uint8_t offs);
 uint16_t Xcp_GetWord(Xcp_PDUType const * const value, uint8_t offs);
@@ -556,6 +743,7 @@ void XcpTl_DeInit(void);
 int16_t XcpTl_FrameAvailable(uint32_t sec, uint32_t usec);
 void XcpTl_RxHandler(void);
 void XcpTl_Send(uint8_t const * buf, uint16_t len);
+bool XcpTl_TxReady(void);
 void XcpTl_MainFunction(void);
 void XcpTl_SaveConnection(void);
 void XcpTl_ReleaseConnection(void);
@@ -571,9 +759,19 @@ bool Xcp_HookFunction_GetId(uint8_t idType);
 bool Xcp_HookFunction_GetSeed(uint8_t resource, Xcp_1DArrayType * result);
 bool Xcp_HookFunction_Unlock(uint8_t resource, Xcp_1DArrayType const * key);
 
-bool Xcp_HookFunction_CheckMemoryAccess(Xcp_MtaType mta, Xcp_MemoryAccessType access, bool programming);
+bool Xcp_HookFunction_CheckMemoryAccess(Xcp_MtaType mta, Xcp_MemoryAccessType access, bool programming);
 
-/*
+#if XCP_MEMORY_REGIONS > 0
+/* User supplied, sorted by ext:address, regions must not overlap. */
+extern const Xcp_MemoryRegionType Xcp_MemoryRegions[XCP_MEMORY_REGIONS];
+#endif // XCP_MEMORY_REGIONS
+
+#if XCP_ENABLE_PAG_COMMANDS == XCP_ON
+/* User supplied, segments must not overlap. */
+extern const Xcp_PagSegmentType Xcp_PagSegments[XCP_PAG_SEGMENTS];
+#endif // XCP_ENABLE_PAG_COMMANDS
+
+/*
 **  Hardware dependent stuff.
 */
 void XcpHw_Init(void);
@@ -583,25 +781,45 @@ extern Xcp_PDUType Xcp_PduIn;
 extern Xcp_PDUType Xcp_PduOut;
 
 
-#if (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_16) || (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT)
-typedef uint16_t Xcp_ChecksumType;
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_32
+/* Wide enough for every method, narrower results are zero-extended. */
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_USER_DEFINED)
+typedef uint64_t Xcp_ChecksumType;
+
+#if (XCP_CHECKSUM_CHUNK_SIZE % 64) != 0
+    #error XCP_CHECKSUM_CHUNK_SIZE must be a multiple of 64 (the stripe size of the user-defined hash)
+#endif // XCP_CHECKSUM_CHUNK_SIZE
+#else
 typedef uint32_t Xcp_ChecksumType;
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_11
-typedef uint8_t Xcp_ChecksumType;
-#elif (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_12) || (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_22)
-typedef uint16_t Xcp_ChecksumType;
-#elif (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_14) || (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_24) || \
-      (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_44)
-typedef uint32_t Xcp_ChecksumType;
-#endif // XCP_CHECKSUM_METHOD
+#endif // XCP_CHECKSUM_METHOD_XCP_USER_DEFINED
+
+#if (XCP_CHECKSUM_CHUNK_SIZE % 4) != 0
+    #error XCP_CHECKSUM_CHUNK_SIZE must be a multiple of 4 (the largest checksum element size)
+#endif // XCP_CHECKSUM_CHUNK_SIZE
 
 void Xcp_ChecksumInit(void);
-Xcp_ChecksumType Xcp_CalculateChecksum(uint8_t const * ptr, uint32_t length, Xcp_ChecksumType startValue, bool isFirstCall);
-void Xcp_ChecksumMainFunction(void);
+Xcp_ChecksumType Xcp_CalculateChecksum(uint8_t const * ptr, uint32_t length, Xcp_ChecksumType startValue, bool isFirstCall);
+Xcp_ChecksumType Xcp_ChecksumCombine(Xcp_ChecksumType first, Xcp_ChecksumType second, uint32_t secondLength);
+bool Xcp_SetChecksumMethod(uint8_t method);
+uint8_t Xcp_GetChecksumMethod(void);
+uint8_t Xcp_ChecksumElementSize(void);
+uint32_t Xcp_ChecksumResponseValue(Xcp_ChecksumType checksum);
+uint32_t Xcp_ChecksumMainFunction(void);
 void Xcp_SendChecksumPositiveResponse(Xcp_ChecksumType checksum);
 void Xcp_SendChecksumOutOfRangeResponse(void);
-void Xcp_StartChecksumCalculation(uint8_t const * ptr, uint32_t size);
+void Xcp_StartChecksumCalculation(uint8_t const * ptr, uint32_t size);
+void Xcp_ChecksumCancel(void);
+bool Xcp_ChecksumIsPending(void);
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+bool Xcp_ChecksumRegisterRegion(uint8_t const * base, uint32_t size);
+void Xcp_ChecksumMarkDirty(uint8_t const * ptr, uint32_t length);
+bool Xcp_ChecksumFromIndex(uint8_t const * ptr, uint32_t size, Xcp_ChecksumType * result);
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+#if XCP_ENABLE_BUILD_CHECKSUM_HOOK == XCP_ON
+bool Xcp_HookFunction_BuildChecksum(Xcp_MtaType mta, uint32_t length, Xcp_ChecksumType * result);
+#endif // XCP_ENABLE_BUILD_CHECKSUM_HOOK
+#if (XCP_ENABLE_PAG_COMMANDS == XCP_ON) && (XCP_ENABLE_COPY_CAL_PAGE_HOOK == XCP_ON)
+bool Xcp_HookFunction_CopyCalPage(uint8_t srcSegment, uint8_t srcPage, uint8_t dstSegment, uint8_t dstPage, uint8_t ** dstData);
+#endif // XCP_ENABLE_COPY_CAL_PAGE_HOOK
 
 #if XCP_EXTERN_C_GUARDS == XCP_ON
 #if defined(__cplusplus)
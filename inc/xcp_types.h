@@ -49,8 +49,20 @@ extern "C"
     #endif
 #endif
 
+/*
+**  Use <stdint.h> whenever there is one: system and intrinsics headers
+**  (SIMD, pthreads) pull it in anyway and would clash with the typedefs below.
+*/
+#if defined(C99_COMPILER)
+    #define XCP_HAS_STDINT_H
+#elif defined(__has_include)
+    #if __has_include(<stdint.h>) && __has_include(<stdbool.h>)
+        #define XCP_HAS_STDINT_H
+    #endif
+#endif
 
-#if defined(__CSMC__)  || !defined(C99_COMPILER) || !defined(C11_COMPILER)
+
+#if defined(__CSMC__)  || !defined(XCP_HAS_STDINT_H)
 typedef unsigned char       bool;
 
 typedef signed char         int8_t;
@@ -62,6 +74,14 @@ typedef unsigned long       uint32_t;
 
 typedef signed long long    int64_t;
 typedef unsigned long long  uint64_t;
+
+#if defined(__UINTPTR_TYPE__)
+typedef __UINTPTR_TYPE__    uintptr_t;
+#elif defined(_WIN64)
+typedef unsigned long long  uintptr_t;
+#else
+typedef unsigned long       uintptr_t;
+#endif // __UINTPTR_TYPE__
 #else
 
 
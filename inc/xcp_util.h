@@ -40,6 +40,9 @@ extern "C"
 void Xcp_MemCopy(void * dst, void * src, uint32_t len);
 void Xcp_MemSet(void * dest, uint8_t fill_char, uint32_t len);
 bool Xcp_MemCmp(void const * dst, void const * src, uint32_t len);
+void Xcp_MemCopyVolatile(void volatile * dst, void const volatile * src, uint32_t len);
+void Xcp_MemTransfer(void * dst, void const * src, uint32_t len, bool device);
+void Xcp_MemModify(uint8_t * ptr, uint8_t const * andMask, uint8_t const * xorMask, uint8_t len);
 void Xcp_Hexdump(uint8_t const * buf, uint16_t sz);
 void Xcp_Itoa(uint32_t value, uint8_t base, uint8_t * buf);
 
@@ -329,6 +329,22 @@ void XcpTl_Send(uint8_t const * buf, uint16_t len)
 }
 
 
+/*
+**  The socket can take another frame without blocking.
+*/
+bool XcpTl_TxReady(void)
+{
+    struct timeval timeout;
+    fd_set fds;
+    SOCKET sock = (XcpTl_Connection.socketType == SOCK_STREAM) ? XcpTl_Connection.connectedSocket : XcpTl_Connection.boundSocket;
+
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 0;
+    FD_ZERO(&fds);
+    FD_SET(sock, &fds);
+    return (bool)(select(0, 0, &fds, 0, &timeout) > 0);
+}
+
 void XcpTl_SaveConnection(void)
 {
     CopyMemory(&XcpTl_Connection.connectionAddress, &XcpTl_Connection.currentAddress, sizeof(SOCKADDR_STORAGE));
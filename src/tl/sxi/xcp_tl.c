@@ -156,6 +156,15 @@ void XcpTl_Send(uint8_t const * buf, uint16_t len)
     fputs("\n", stdout);
 }
 
+bool XcpTl_TxReady(void)
+{
+#if defined(ARDUINO)
+    return (bool)(Serial.availableForWrite() >= (XCP_MAX_CTO + XCP_TRANSPORT_LAYER_LENGTH_SIZE + XCP_TRANSPORT_LAYER_COUNTER_SIZE));
+#else
+    return (bool)XCP_TRUE;
+#endif
+}
+
 void XcpTl_SaveConnection(void)
 {
 
@@ -41,7 +41,20 @@
 /*
 ** Local Types.
 */
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_ON
+typedef struct tagXcp_SlaveBlockType {
+    uint8_t const * source;
+    uint8_t remaining;      /* Elements still to be sent. */
+    bool device;
+} Xcp_SlaveBlockType;
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
 
+#if XCP_ENABLE_MASTER_BLOCKMODE == XCP_ON
+typedef struct tagXcp_MasterBlockType {
+    uint8_t * destination;
+    uint8_t remaining;      /* Elements still expected from DOWNLOAD_NEXT. */
+} Xcp_MasterBlockType;
+#endif // XCP_ENABLE_MASTER_BLOCKMODE
 
 
 /*
@@ -59,6 +72,17 @@ static Xcp_StateType Xcp_State;
 
 static Xcp_SendCalloutType Xcp_SendCallout = (Xcp_SendCalloutType)XCP_NULL;
 static const Xcp_StationIDType Xcp_StationID = { UINT16(sizeof(XCP_STATION_ID) - UINT16(1)), (uint8_t const *)XCP_STATION_ID };
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+static Xcp_AddressMappingType Xcp_AddressMappings[XCP_ADDRESS_MAPPER_ENTRIES];  /* Sorted by ext:address. */
+static uint8_t Xcp_AddressMappingCount = UINT8(0);
+static uint8_t Xcp_AddressMappingLastHit = UINT8(0);
+#endif // XCP_ENABLE_ADDRESS_MAPPER
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_ON
+static Xcp_SlaveBlockType Xcp_SlaveBlock;
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
+#if XCP_ENABLE_MASTER_BLOCKMODE == XCP_ON
+static Xcp_MasterBlockType Xcp_MasterBlock;
+#endif // XCP_ENABLE_MASTER_BLOCKMODE
 
 void Xcp_WriteMemory(void * dest, void * src, uint16_t count);
 void Xcp_ReadMemory(void * dest, void * src, uint16_t count);
@@ -83,16 +107,16 @@ static uint8_t Xcp_SetResetBit8(uint8_t result, uint8_t value, uint8_t flag);
         }                                               \
     } while (0)
 
-#if XCP_ENABLE_CHECK_MEMORY_ACCESS == XCP_ON
-#define XCP_CHECK_MEMORY_ACCESS(m, a, p)                                \
+#if (XCP_ENABLE_CHECK_MEMORY_ACCESS == XCP_ON) || (XCP_MEMORY_REGIONS > 0)
+#define XCP_CHECK_MEMORY_ACCESS(m, l, a, p)                             \
     do {                                                                \
-            if (!Xcp_HookFunction_CheckMemoryAccess((m), (a), (p))) {   \
+            if (!Xcp_CheckMemoryAccess((m), (l), (a), (p))) {           \
             Xcp_SendResult(ERR_ACCESS_DENIED);                          \
             return;                                                     \
         }                                                               \
     } while (0)
 #else
-#define XCP_CHECK_MEMORY_ACCESS(mta, access)
+#define XCP_CHECK_MEMORY_ACCESS(m, l, a, p)
 #endif /* XCP_ENABLE_CHECK_MEMORY_ACCESS */
 
 
@@ -103,7 +127,21 @@ static bool Xcp_IsProtected(uint8_t resource);
 static void Xcp_DefaultResourceProtection(void);
 static void Xcp_Disconnect(void);
 static void Xcp_SendResult(Xcp_ReturnType result);
+static void Xcp_SendFrame(uint8_t * frame, uint16_t len);
 static void Xcp_CommandNotImplemented_Res(Xcp_PDUType const * const pdu);
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_ON
+static void Xcp_SlaveBlockContinue(void);
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
+#if XCP_MEMORY_REGIONS > 0
+static Xcp_MemoryRegionType const * Xcp_FindMemoryRegion(Xcp_MtaType mta);
+#endif // XCP_MEMORY_REGIONS
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+static bool Xcp_AddressMappingLess(uint8_t ext, uint32_t address, Xcp_AddressMappingType const * mapping);
+static uint8_t * Xcp_AddressMappingResolve(Xcp_AddressMappingType const * mapping, Xcp_MtaType mta, uint32_t length);
+#endif // XCP_ENABLE_ADDRESS_MAPPER
+#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON && XCP_CHECKSUM_WORKER_THREAD == XCP_ON
+static bool Xcp_ConflictsWithChecksum(uint8_t cmd);
+#endif // XCP_CHECKSUM_WORKER_THREAD
 
 static void Xcp_Connect_Res(Xcp_PDUType const * const pdu);
 static void Xcp_Disconnect_Res(Xcp_PDUType const * const pdu);
@@ -144,6 +182,7 @@ static void Xcp_UserCmd_Res(Xcp_PDUType const * const pdu);
 #endif // XCP_ENABLE_USER_CMD
 
 #if XCP_ENABLE_CAL_COMMANDS == XCP_ON
+static Xcp_ReturnType Xcp_WriteCalibration(Xcp_MtaType mta, uint8_t * dst, uint8_t const * src, uint32_t length);
 static void Xcp_Download_Res(Xcp_PDUType const * const pdu);
 #if XCP_ENABLE_DOWNLOAD_NEXT == XCP_ON
 static void Xcp_DownloadNext_Res(Xcp_PDUType const * const pdu);
@@ -157,12 +196,11 @@ static void Xcp_ShortDownload_Res(Xcp_PDUType const * const pdu);
 #if XCP_ENABLE_MODIFY_BITS == XCP_ON
 static void Xcp_ModifyBits_Res(Xcp_PDUType const * const pdu);
 #endif // XCP_ENABLE_MODIFY_BITS
-
-static void Xcp_SetCalPage_Res(Xcp_PDUType const * const pdu);
-static void Xcp_GetCalPage_Res(Xcp_PDUType const * const pdu);
 #endif // XCP_ENABLE_CAL_COMMANDS
 
 #if XCP_ENABLE_PAG_COMMANDS == XCP_ON
+static void Xcp_SetCalPage_Res(Xcp_PDUType const * const pdu);
+static void Xcp_GetCalPage_Res(Xcp_PDUType const * const pdu);
 #if XCP_ENABLE_GET_PAG_PROCESSOR_INFO == XCP_ON
 static void Xcp_GetPagProcessorInfo_Res(Xcp_PDUType const * const pdu);
 #endif // XCP_ENABLE_GET_PAG_PROCESSOR_INFO
@@ -178,7 +216,7 @@ static void Xcp_SetSegmentMode_Res(Xcp_PDUType const * const pdu);
 #if XCP_ENABLE_GET_SEGMENT_MODE == XCP_ON
 static void Xcp_GetSegmentMode_Res(Xcp_PDUType const * const pdu);
 #endif // XCP_ENABLE_GET_SEGMENT_MODE
-#if XCP_ENABLE_COPY_CAL_PAGE
+#if XCP_ENABLE_COPY_CAL_PAGE == XCP_ON
 static void Xcp_CopyCalPage_Res(Xcp_PDUType const * const pdu);
 #endif // XCP_ENABLE_COPY_CAL_PAGE
 #endif // XCP_ENABLE_PAG_COMMANDS
@@ -561,6 +599,12 @@ void Xcp_Init(void)
 
     Xcp_MemSet(&Xcp_State, UINT8(0), (uint32_t)sizeof(Xcp_StateType));
     Xcp_State.busy = XCP_FALSE;
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_ON
+    Xcp_SlaveBlock.remaining = UINT8(0);
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
+#if XCP_ENABLE_MASTER_BLOCKMODE == XCP_ON
+    Xcp_MasterBlock.remaining = UINT8(0);
+#endif // XCP_ENABLE_MASTER_BLOCKMODE
 
     Xcp_DefaultResourceProtection();
 
@@ -571,13 +615,22 @@ void Xcp_Init(void)
     Xcp_State.daqPointer.odt = (XcpDaq_ODTIntegerType)0;
     Xcp_State.daqPointer.odtEntry = (XcpDaq_ODTEntryIntegerType)0;
 #endif // XCP_ENABLE_DAQ_COMMANDS
+#if XCP_ENABLE_PAG_COMMANDS == XCP_ON
+    XcpPag_Init();
+#endif // XCP_ENABLE_PAG_COMMANDS
+#if XCP_CAL_STAGING_SIZE > 0
+    XcpCal_Init();
+#endif // XCP_CAL_STAGING_SIZE
 #if XCP_TRANSPORT_LAYER_COUNTER_SIZE != 0
     Xcp_State.counter = (uint16_t)0;
 #endif // XCP_TRANSPORT_LAYER_COUNTER_SIZE
     XcpHw_Init();
     XcpTl_Init();
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+    (void)Xcp_AddressMapperRegister(XCP_ADDRESS_EXT_INTERNAL, UINT32(0), UINT32(Xcp_StationID.len), (void *)Xcp_StationID.name);
+#endif // XCP_ENABLE_ADDRESS_MAPPER
 
-#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON && XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON
     Xcp_ChecksumInit();
 #endif // XCP_ENABLE_BUILD_CHECKSUM
 }
@@ -605,8 +658,14 @@ static void Xcp_DefaultResourceProtection(void)
 
 static void Xcp_Disconnect(void)
 {
+#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON && XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+    Xcp_ChecksumCancel();
+#endif // XCP_ENABLE_BUILD_CHECKSUM && XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
     XcpTl_ReleaseConnection();
     Xcp_DefaultResourceProtection();
+#if XCP_CAL_STAGING_SIZE > 0
+    XcpCal_Abort();
+#endif // XCP_CAL_STAGING_SIZE
     XcpDaq_StopAllLists();
     XcpDaq_SetProcessorState(XCP_DAQ_STATE_STOPPED);
 }
@@ -621,6 +680,10 @@ void Xcp_MainFunction(void)
 #if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON && XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
     Xcp_ChecksumMainFunction();
 #endif // XCP_ENABLE_BUILD_CHECKSUM && XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_ON
+    Xcp_SlaveBlockContinue();
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
 }
 
 void Xcp_SetMta(Xcp_MtaType mta)
@@ -631,26 +694,39 @@ void Xcp_SetMta(Xcp_MtaType mta)
 Xcp_MtaType Xcp_GetNonPagedAddress(void const * const ptr)
 {
     Xcp_MtaType mta;
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+    uint8_t idx;
+    Xcp_AddressMappingType const * mapping;
+
+    /* Reverse lookup, not time critical. */
+    for (idx = UINT8(0); idx < Xcp_AddressMappingCount; ++idx) {
+        mapping = &Xcp_AddressMappings[idx];
+        if (((uint8_t const *)ptr >= mapping->host) && (UINT32((uint8_t const *)ptr - mapping->host) < mapping->length)) {
+            mta.ext = mapping->ext;
+            mta.address = mapping->address + UINT32((uint8_t const *)ptr - mapping->host);
+            return mta;
+        }
+    }
+#endif // XCP_ENABLE_ADDRESS_MAPPER
 
     mta.ext = (uint8_t)0;
-    mta.address = (uint32_t)ptr;
+    mta.address = UINT32((uintptr_t)ptr);
     return mta;
 }
 
 void Xcp_SendPdu(void)
 {
-    const uint16_t len = Xcp_PduOut.len;
-
-    Xcp_PduOut.data[0] = XCP_LOBYTE(len);
-    Xcp_PduOut.data[1] = XCP_HIBYTE(len);
-#if XCP_TRANSPORT_LAYER_COUNTER_SIZE != 0
-    Xcp_PduOut.data[2] = XCP_LOBYTE(Xcp_State.counter);
-    Xcp_PduOut.data[3] = XCP_HIBYTE(Xcp_State.counter);
-    Xcp_State.counter++;
-#endif // XCP_TRANSPORT_LAYER_COUNTER_SIZE
-
     //DBG_PRINT1("Sending PDU: ");
-    XcpTl_Send(Xcp_PduOut.data, Xcp_PduOut.len + (uint16_t)4);
+    Xcp_SendFrame(Xcp_PduOut.data, Xcp_PduOut.len);
+}
+
+/**
+ * Send a DTO, `frame` must reserve the four transport-layer header bytes,
+ * `len` is the length of the packet following the header.
+ */
+void Xcp_SendDto(uint8_t * frame, uint16_t len)
+{
+    Xcp_SendFrame(frame, len);
 }
 
 
@@ -707,22 +783,87 @@ static void Xcp_Upload(uint8_t len)
 {
     //uint8_t len = pdu->data[1];
     uint8_t * dataOut = Xcp_GetOutPduPtr();
-    Xcp_MtaType dst;
+    uint8_t const * src = Xcp_MapAddress(Xcp_State.mta, UINT32(len));
+    bool const device = Xcp_IsDeviceMemory(Xcp_State.mta);
 
-// TODO: Blockmode!!!
+    if (src == (uint8_t const *)XCP_NULL) {
+        XCP_ERROR_RESPONSE(ERR_ACCESS_DENIED);
+        return;
+    }
+    Xcp_State.mta.address += UINT32(len);   // Advance MTA.
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_ON
+    if (len > UINT8(XCP_MAX_CTO - 1)) {
+        Xcp_SlaveBlock.source = src;
+        Xcp_SlaveBlock.remaining = len;
+        Xcp_SlaveBlock.device = device;
+        Xcp_SlaveBlockContinue();
+        return;
+    }
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
     dataOut[0] = (uint8_t)ERR_SUCCESS;
 
-    dst.address = (uint32_t)(dataOut + 1);  // FIX ME!!!
-    dst.ext = (uint8_t)0;
-
-    Xcp_CopyMemory(dst, Xcp_State.mta, (uint32_t)len);
-
-    Xcp_State.mta.address += UINT32(len);   // Advance MTA.
+    Xcp_MemTransfer(dataOut + 1, src, (uint32_t)len, device);
 
     Xcp_SetPduOutLen(UINT16(len + 1));
     Xcp_SendPdu();
 }
 
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_ON
+/*
+**  Block mode UPLOAD: one positive response per MAX_CTO - 1 elements, sent as
+**  long as the transport layer is ready, the rest from Xcp_MainFunction().
+*/
+static void Xcp_SlaveBlockContinue(void)
+{
+    uint8_t * dataOut;
+    uint8_t len;
+
+    while ((Xcp_SlaveBlock.remaining > UINT8(0)) && XcpTl_TxReady()) {
+        len = XCP_MIN(Xcp_SlaveBlock.remaining, UINT8(XCP_MAX_CTO - 1));
+        dataOut = Xcp_GetOutPduPtr();
+        dataOut[0] = (uint8_t)ERR_SUCCESS;
+        Xcp_MemTransfer(dataOut + 1, Xcp_SlaveBlock.source, (uint32_t)len, Xcp_SlaveBlock.device);
+        Xcp_SlaveBlock.source += len;
+        Xcp_SlaveBlock.remaining -= len;
+        Xcp_SetPduOutLen(UINT16(len + 1));
+        Xcp_SendPdu();
+    }
+}
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
+
+#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON && XCP_CHECKSUM_WORKER_THREAD == XCP_ON
+/*
+**  Commands that move the MTA, touch memory or pages, or start another
+**  checksum have to wait for a background BUILD_CHECKSUM; everything else
+**  (GET_STATUS, SYNCH, DAQ, ...) is served meanwhile.
+*/
+static bool Xcp_ConflictsWithChecksum(uint8_t cmd)
+{
+    bool result;
+
+    switch (cmd) {
+        case XCP_SET_MTA:
+        case XCP_UPLOAD:
+        case XCP_SHORT_UPLOAD:
+        case XCP_BUILD_CHECKSUM:
+        case XCP_DOWNLOAD:
+        case XCP_DOWNLOAD_NEXT:
+        case XCP_DOWNLOAD_MAX:
+        case XCP_SHORT_DOWNLOAD:
+        case XCP_MODIFY_BITS:
+        case XCP_SET_CAL_PAGE:
+        case XCP_COPY_CAL_PAGE:
+            result = (bool)XCP_TRUE;
+            break;
+        default:
+            /* All programming commands. */
+            result = ((cmd >= UINT8(XCP_PROGRAM_VERIFY)) && (cmd <= UINT8(XCP_PROGRAM_START))) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+            break;
+    }
+    return result;
+}
+#endif // XCP_CHECKSUM_WORKER_THREAD
+
 /**
  * Entry point, needs to be "wired" to CAN-Rx interrupt.
  *
@@ -736,9 +877,32 @@ void Xcp_DispatchCommand(Xcp_PDUType const * const pdu)
 
     if (Xcp_State.connected == (bool)XCP_TRUE) {
         //DBG_PRINT2("CMD: [%02X]\n", cmd);
-        if (Xcp_IsBusy()) {
+        if ((UINT8(0xff) - cmd) >= UINT8(XCP_ARRAY_SIZE(Xcp_ServerCommands))) {
+            /* Below the lowest command code: STIM DTO or garbage. */
+#if (XCP_ENABLE_DAQ_COMMANDS == XCP_ON) && (XCP_ENABLE_STIM == XCP_ON)
+            if (cmd <= UINT8(0xBF)) {
+                XcpDaq_StimReceive(pdu);
+            } else {
+                Xcp_CommandNotImplemented_Res(pdu);
+            }
+#else
+            Xcp_CommandNotImplemented_Res(pdu);
+#endif // XCP_ENABLE_STIM
+        } else if (Xcp_IsBusy()) {
+            XCP_BUSY_RESPONSE();
+#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON && XCP_CHECKSUM_WORKER_THREAD == XCP_ON
+        } else if (Xcp_ChecksumIsPending() && Xcp_ConflictsWithChecksum(cmd)) {
             XCP_BUSY_RESPONSE();
+#endif // XCP_CHECKSUM_WORKER_THREAD
         } else {
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_ON
+            Xcp_SlaveBlock.remaining = UINT8(0);    /* Any command aborts a pending block transfer. */
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
+#if XCP_ENABLE_MASTER_BLOCKMODE == XCP_ON
+            if (cmd != UINT8(XCP_DOWNLOAD_NEXT)) {
+                Xcp_MasterBlock.remaining = UINT8(0);
+            }
+#endif // XCP_ENABLE_MASTER_BLOCKMODE
             Xcp_ServerCommands[UINT8(0xff) - cmd](pdu);
         }
     } else {    // not connected.
@@ -796,6 +960,12 @@ static void Xcp_Connect_Res(Xcp_PDUType const * const pdu)
         Xcp_State.connected = (bool)XCP_TRUE;
         // TODO: Init stuff
     }
+#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON
+    (void)Xcp_SetChecksumMethod(UINT8(XCP_CHECKSUM_METHOD));
+#endif // XCP_ENABLE_BUILD_CHECKSUM
+#if XCP_CAL_STAGING_SIZE > 0
+    XcpCal_Abort();     /* Writes of the new session must not end up in a stale transaction. */
+#endif // XCP_CAL_STAGING_SIZE
 
 #if XCP_ENABLE_PGM_COMMANDS == XCP_ON
     resource |= XCP_RESOURCE_PGM;
@@ -840,6 +1010,12 @@ static void Xcp_Disconnect_Res(Xcp_PDUType const * const pdu)
 
 static void Xcp_GetStatus_Res(Xcp_PDUType const * const pdu)   // TODO: Implement!!!
 {
+#if XCP_ENABLE_DAQ_COMMANDS == XCP_ON
+    const uint16_t sessionConfigurationId = XCP_LOWORD(XcpDaq_GetFingerprint());
+#else
+    const uint16_t sessionConfigurationId = UINT16(0);
+#endif // XCP_ENABLE_DAQ_COMMANDS
+
     DBG_PRINT1("GET_STATUS\n");
 
     Xcp_Send8(UINT8(6), UINT8(0xff),
@@ -850,8 +1026,8 @@ static void Xcp_GetStatus_Res(Xcp_PDUType const * const pdu)   // TODO: Implemen
         UINT8(0x00),  // Everything is unprotected.
 #endif // XCP_ENABLE_RESOURCE_PROTECTION
         UINT8(0x00),  // Reserved
-        UINT8(0),     // Session configuration id
-        UINT8(0),     // "                      "
+        XCP_LOBYTE(sessionConfigurationId),   // Session configuration id
+        XCP_HIBYTE(sessionConfigurationId),   // "                      "
         UINT8(0), UINT8(0)
     );
 }
@@ -1034,13 +1210,14 @@ static void Xcp_Upload_Res(Xcp_PDUType const * const pdu)
 {
     uint8_t len = Xcp_GetByte(pdu, UINT8(1));
 
-// TODO: Blockmode!!!
     DBG_PRINT2("UPLOAD [len: %u]\n", len);
-    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, XCP_MEM_ACCESS_READ, XCP_FALSE);
+    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, UINT32(len), XCP_MEM_ACCESS_READ, XCP_FALSE);
+#if XCP_ENABLE_SLAVE_BLOCKMODE == XCP_OFF
     if (len > UINT8(XCP_MAX_CTO - 1)) {
         XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
         return;
     }
+#endif // XCP_ENABLE_SLAVE_BLOCKMODE
 
     Xcp_Upload(len);
 }
@@ -1052,9 +1229,7 @@ static void Xcp_ShortUpload_Res(Xcp_PDUType const * const pdu)
 {
     uint8_t len = Xcp_GetByte(pdu, UINT8(1));
 
-// TODO: Blockmode!!!
     DBG_PRINT2("SHORT-UPLOAD [len: %u]\n", len);
-    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, XCP_MEM_ACCESS_READ, XCP_FALSE);
     if (len > UINT8(XCP_MAX_CTO - 1)) {
         XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
         return;
@@ -1062,6 +1237,7 @@ static void Xcp_ShortUpload_Res(Xcp_PDUType const * const pdu)
 
     Xcp_State.mta.ext = Xcp_GetByte(pdu, UINT8(3));
     Xcp_State.mta.address = Xcp_GetDWord(pdu, UINT8(4));
+    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, UINT32(len), XCP_MEM_ACCESS_READ, XCP_FALSE);
     Xcp_Upload(len);
 }
 #endif // XCP_ENABLE_SHORT_UPLOAD
@@ -1089,14 +1265,16 @@ static void Xcp_SetMta_Res(Xcp_PDUType const * const pdu)
 #if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON
 void Xcp_SendChecksumPositiveResponse(Xcp_ChecksumType checksum)
 {
+    uint32_t const value = Xcp_ChecksumResponseValue(checksum);
+
     Xcp_Send8(UINT8(8), UINT8(0xff),
-        XCP_CHECKSUM_METHOD,
+        Xcp_GetChecksumMethod(),
         UINT8(0),
         UINT8(0),
-        XCP_LOBYTE(XCP_LOWORD(checksum)),
-        XCP_HIBYTE(XCP_LOWORD(checksum)),
-        XCP_LOBYTE(XCP_HIWORD(checksum)),
-        XCP_HIBYTE(XCP_HIWORD(checksum))
+        XCP_LOBYTE(XCP_LOWORD(value)),
+        XCP_HIBYTE(XCP_LOWORD(value)),
+        XCP_LOBYTE(XCP_HIWORD(value)),
+        XCP_HIBYTE(XCP_HIWORD(value))
     );
 }
 
@@ -1121,7 +1299,7 @@ static void Xcp_BuildChecksum_Res(Xcp_PDUType const * const pdu)
     uint8_t const * ptr;
 
     DBG_PRINT2("BUILD_CHECKSUM [blocksize: %u]\n", blockSize);
-    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, XCP_MEM_ACCESS_READ, XCP_FALSE);
+    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, blockSize, XCP_MEM_ACCESS_READ, XCP_FALSE);
 #if XCP_CHECKSUM_MAXIMUM_BLOCK_SIZE > 0
     /* We need to range check. */
     if (blockSize > UINT32(XCP_CHECKSUM_MAXIMUM_BLOCK_SIZE)) {
@@ -1129,10 +1307,30 @@ static void Xcp_BuildChecksum_Res(Xcp_PDUType const * const pdu)
         return;
     }
 #endif
+    if ((blockSize % UINT32(Xcp_ChecksumElementSize())) != UINT32(0)) {
+        Xcp_SendResult(ERR_OUT_OF_RANGE);
+        return;
+    }
 
-    ptr = (uint8_t const *)Xcp_State.mta.address;
     // The MTA will be post-incremented by the block size.
 
+#if XCP_ENABLE_BUILD_CHECKSUM_HOOK == XCP_ON
+    if (Xcp_HookFunction_BuildChecksum(Xcp_State.mta, blockSize, &checksum)) {   /* User supplied callout, e.g. FlsEmu_ChecksumAddress(). */
+        Xcp_SendChecksumPositiveResponse(checksum);
+        return;
+    }
+#endif // XCP_ENABLE_BUILD_CHECKSUM_HOOK
+    ptr = Xcp_MapAddress(Xcp_State.mta, blockSize);
+    if (ptr == (uint8_t const *)XCP_NULL) {
+        Xcp_SendResult(ERR_ACCESS_DENIED);
+        return;
+    }
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+    if (Xcp_ChecksumFromIndex(ptr, blockSize, &checksum)) {
+        Xcp_SendChecksumPositiveResponse(checksum);
+        return;
+    }
+#endif // XCP_CHECKSUM_INDEX_REGIONS
 #if XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_OFF
     checksum = Xcp_CalculateChecksum(ptr, blockSize, (Xcp_ChecksumType)0, XCP_TRUE);
     Xcp_SendChecksumPositiveResponse(checksum);
@@ -1163,10 +1361,31 @@ static void Xcp_TransportLayerCmd_Res(Xcp_PDUType const * const pdu)
 #endif // XCP_ENABLE_TRANSPORT_LAYER_CMD
 
 
-#if XCP_ENABLE_USER_CMD
+#if XCP_ENABLE_USER_CMD == XCP_ON
 static void Xcp_UserCmd_Res(Xcp_PDUType const * const pdu)
 {
-
+    uint8_t subCommand = Xcp_GetByte(pdu, UINT8(1));
+
+    DBG_PRINT2("USER_CMD [sub-command: 0x%02x]\n", subCommand);
+    switch (subCommand) {
+#if XCP_CAL_STAGING_SIZE > 0
+        case XCP_USER_CMD_CAL_BEGIN:
+            XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+            Xcp_SendResult(XcpCal_Begin());
+            break;
+        case XCP_USER_CMD_CAL_COMMIT:
+            XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+            Xcp_SendResult(XcpCal_Commit());
+            break;
+        case XCP_USER_CMD_CAL_ABORT:
+            XcpCal_Abort();
+            XCP_POSITIVE_RESPONSE();
+            break;
+#endif // XCP_CAL_STAGING_SIZE
+        default:
+            XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+            break;
+    }
 }
 #endif // XCP_ENABLE_USER_CMD
 
@@ -1177,21 +1396,145 @@ static void Xcp_UserCmd_Res(Xcp_PDUType const * const pdu)
 **
 */
 #if XCP_ENABLE_CAL_COMMANDS == XCP_ON
+/*
+**  All DOWNLOADs end up here: straight to target memory, or into the open
+**  calibration transaction (s. XcpCal_Begin()).
+*/
+static Xcp_ReturnType Xcp_WriteCalibration(Xcp_MtaType mta, uint8_t * dst, uint8_t const * src, uint32_t length)
+{
+    bool const device = Xcp_IsDeviceMemory(mta);
+
+#if XCP_CAL_STAGING_SIZE > 0
+    if (XcpCal_IsStaging()) {
+        return XcpCal_Stage(dst, src, length, device);
+    }
+#endif // XCP_CAL_STAGING_SIZE
+    Xcp_MemTransfer(dst, src, length, device);
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+    Xcp_ChecksumMarkDirty(dst, length);
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+    return ERR_SUCCESS;
+}
+
 static void Xcp_Download_Res(Xcp_PDUType const * const pdu)
 {
     uint8_t len = Xcp_GetByte(pdu, UINT8(1));
+    uint8_t chunk = len;
+    uint8_t * dst;
+    Xcp_ReturnType result;
 
-// TODO: Blockmode!!!
     DBG_PRINT2("DOWNLOAD [len: %u]\n", len);
-    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, XCP_MEM_ACCESS_WRITE, XCP_FALSE);
-    //Xcp_CopyMemory(Xcp_State.mta, pdu->data + 2, (uint32_t)len);
-    Xcp_MemCopy((void*)Xcp_State.mta.address, pdu->data + 2, (uint32_t)len);
+#if XCP_ENABLE_MASTER_BLOCKMODE == XCP_ON
+    if (len > UINT8(XCP_MAX_CTO - 2)) {
+        /* Start of a block, the rest follows with DOWNLOAD_NEXT. */
+        if (((UINT16(len) + UINT16(XCP_MAX_CTO - 3)) / UINT16(XCP_MAX_CTO - 2)) > UINT16(XCP_MAX_BS)) {
+            XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+            return;
+        }
+        chunk = UINT8(XCP_MAX_CTO - 2);
+    }
+#else
+    if (len > UINT8(XCP_MAX_CTO - 2)) {
+        XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+        return;
+    }
+#endif // XCP_ENABLE_MASTER_BLOCKMODE
+    if (pdu->len < UINT16(UINT16(chunk) + UINT16(2))) {
+        XCP_ERROR_RESPONSE(ERR_CMD_SYNTAX);
+        return;
+    }
+    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, UINT32(len), XCP_MEM_ACCESS_WRITE, XCP_FALSE);
+    dst = Xcp_MapAddress(Xcp_State.mta, UINT32(len));
+    if (dst == (uint8_t *)XCP_NULL) {
+        XCP_ERROR_RESPONSE(ERR_ACCESS_DENIED);
+        return;
+    }
+    result = Xcp_WriteCalibration(Xcp_State.mta, dst, pdu->data + 2, UINT32(chunk));
+    if (result != ERR_SUCCESS) {
+        XCP_ERROR_RESPONSE(result);
+        return;
+    }
 
-    Xcp_State.mta.address += UINT32(len);
+    Xcp_State.mta.address += UINT32(chunk);
+#if XCP_ENABLE_MASTER_BLOCKMODE == XCP_ON
+    if (chunk < len) {
+        Xcp_MasterBlock.destination = dst + chunk;
+        Xcp_MasterBlock.remaining = UINT8(len - chunk);
+        return; /* No response until the block is complete. */
+    }
+#endif // XCP_ENABLE_MASTER_BLOCKMODE
 
     XCP_POSITIVE_RESPONSE();
 }
 
+#if XCP_ENABLE_DOWNLOAD_NEXT == XCP_ON
+static void Xcp_DownloadNext_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t len = Xcp_GetByte(pdu, UINT8(1));   /* Elements remaining, incl. this packet. */
+    uint8_t const expected = Xcp_MasterBlock.remaining;
+    uint8_t chunk;
+    Xcp_ReturnType result;
+
+    DBG_PRINT2("DOWNLOAD_NEXT [len: %u]\n", len);
+    if ((expected == UINT8(0)) || (len != expected)) {
+        Xcp_MasterBlock.remaining = UINT8(0);
+        Xcp_Send8(UINT8(3), UINT8(0xfe), UINT8(ERR_SEQUENCE), expected, UINT8(0), UINT8(0), UINT8(0), UINT8(0), UINT8(0));
+        return;
+    }
+    chunk = XCP_MIN(len, UINT8(XCP_MAX_CTO - 2));
+    if (pdu->len < UINT16(chunk + UINT8(2))) {
+        Xcp_MasterBlock.remaining = UINT8(0);
+        XCP_ERROR_RESPONSE(ERR_CMD_SYNTAX);
+        return;
+    }
+    result = Xcp_WriteCalibration(Xcp_State.mta, Xcp_MasterBlock.destination, pdu->data + 2, UINT32(chunk));
+    if (result != ERR_SUCCESS) {
+        XCP_ERROR_RESPONSE(result);
+        Xcp_MasterBlock.remaining = UINT8(0);
+        return;
+    }
+    Xcp_MasterBlock.destination += chunk;
+    Xcp_MasterBlock.remaining -= chunk;
+    Xcp_State.mta.address += UINT32(chunk);
+
+    if (Xcp_MasterBlock.remaining == UINT8(0)) {
+        XCP_POSITIVE_RESPONSE();
+    }
+}
+#endif // XCP_ENABLE_DOWNLOAD_NEXT
+
+#if XCP_ENABLE_DOWNLOAD_MAX == XCP_ON
+/*
+**  The whole CTO except the command byte is payload, i.e. MAX_CTO - 1 elements
+**  are written straight from the receive buffer to the target.
+*/
+static void Xcp_DownloadMax_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t * dst;
+    Xcp_ReturnType result;
+
+    DBG_PRINT1("DOWNLOAD_MAX\n");
+    if (pdu->len < UINT16(XCP_MAX_CTO)) {
+        XCP_ERROR_RESPONSE(ERR_CMD_SYNTAX);
+        return;
+    }
+    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, UINT32(XCP_MAX_CTO - 1), XCP_MEM_ACCESS_WRITE, XCP_FALSE);
+    dst = Xcp_MapAddress(Xcp_State.mta, UINT32(XCP_MAX_CTO - 1));
+    if (dst == (uint8_t *)XCP_NULL) {
+        XCP_ERROR_RESPONSE(ERR_ACCESS_DENIED);
+        return;
+    }
+    result = Xcp_WriteCalibration(Xcp_State.mta, dst, pdu->data + 1, UINT32(XCP_MAX_CTO - 1));
+    if (result != ERR_SUCCESS) {
+        XCP_ERROR_RESPONSE(result);
+        return;
+    }
+    Xcp_State.mta.address += UINT32(XCP_MAX_CTO - 1);
+
+    XCP_POSITIVE_RESPONSE();
+}
+#endif // XCP_ENABLE_DOWNLOAD_MAX
+
 #if XCP_ENABLE_SHORT_DOWNLOAD == XCP_ON
 static void Xcp_ShortDownload_Res(Xcp_PDUType const * const pdu)
 {
@@ -1199,20 +1542,37 @@ static void Xcp_ShortDownload_Res(Xcp_PDUType const * const pdu)
     uint8_t addrExt = Xcp_GetByte(pdu, UINT8(3));
     uint32_t address = Xcp_GetDWord(pdu, UINT8(4));
     Xcp_MtaType dst;
+    uint8_t * ptr;
+    Xcp_ReturnType result;
 
     DBG_PRINT4("SHORT-DOWNLOAD [len: %u address: 0x%08x ext: 0x%02x]\n", len, address, addrExt);
     dst.address = address;
     dst.ext = addrExt;
-    XCP_CHECK_MEMORY_ACCESS(dst, XCP_MEM_ACCESS_WRITE, XCP_FALSE);
     if (len > (XCP_MAX_CTO - UINT8(8))) {
         XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
         return;
     }
+    if (pdu->len < UINT16(UINT16(len) + UINT16(8))) {
+        XCP_ERROR_RESPONSE(ERR_CMD_SYNTAX);
+        return;
+    }
+    XCP_CHECK_MEMORY_ACCESS(dst, UINT32(len), XCP_MEM_ACCESS_WRITE, XCP_FALSE);
 
     //Xcp_Hexdump(pdu->data + 8, len);
 
-    Xcp_MemCopy((void*)dst.address, pdu->data + 8, (uint32_t)len);
-    Xcp_State.mta.address += UINT32(len);
+    ptr = Xcp_MapAddress(dst, UINT32(len));
+    if (ptr == (uint8_t *)XCP_NULL) {
+        XCP_ERROR_RESPONSE(ERR_ACCESS_DENIED);
+        return;
+    }
+    result = Xcp_WriteCalibration(dst, ptr, pdu->data + 8, UINT32(len));
+    if (result != ERR_SUCCESS) {
+        XCP_ERROR_RESPONSE(result);
+        return;
+    }
+    /* MTA points behind the written block, like SHORT_UPLOAD. */
+    Xcp_State.mta.ext = addrExt;
+    Xcp_State.mta.address = address + UINT32(len);
 
     XCP_POSITIVE_RESPONSE();
 }
@@ -1225,12 +1585,54 @@ static void Xcp_ModifyBits_Res(Xcp_PDUType const * const pdu)
     uint8_t shiftValue = Xcp_GetByte(pdu, UINT8(1));
     uint16_t andMask = Xcp_GetWord(pdu, UINT8(2));
     uint16_t xorMask = Xcp_GetWord(pdu, UINT8(4));
-    uint32_t * vp;
+    uint32_t clearBits;
+    uint32_t toggleBits;
+    uint8_t andBytes[4];
+    uint8_t xorBytes[4];
+    uint8_t * vp;
+    Xcp_MtaType mta;
+    uint8_t idx;
+    uint8_t lane;
+    uint8_t first = UINT8(4);
+    uint8_t last = UINT8(0);
 
     DBG_PRINT4("MODIFY-BITS [shiftValue: 0x%02X andMask: 0x%04x ext: xorMask: 0x%04x]\n", shiftValue, andMask, xorMask);
-    XCP_CHECK_MEMORY_ACCESS(Xcp_State.mta, XCP_MEM_ACCESS_WRITE, XCP_FALSE);
-    vp = (uint32_t*)Xcp_State.mta.address;
-    *vp = ((*vp) & ((~((uint32_t)(((uint16_t)~andMask) << shiftValue)))) ^ ((uint32_t)(xorMask << shiftValue)));
+    if (shiftValue > UINT8(31)) {
+        XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+        return;
+    }
+    /* Bits shifted beyond the 32 bit word are dropped. */
+    clearBits = UINT32(UINT64(UINT16(~andMask)) << shiftValue);
+    toggleBits = UINT32(UINT64(xorMask) << shiftValue);
+
+    /*
+    **  Split the masks into bytes in memory order, so only the bytes actually
+    **  touched are accessed -- atomically and with their natural alignment.
+    */
+    for (idx = UINT8(0); idx < UINT8(4); ++idx) {
+        lane = (XCP_BYTE_ORDER == XCP_BYTE_ORDER_INTEL) ? idx : UINT8(UINT8(3) - idx);
+        andBytes[idx] = UINT8(~(clearBits >> (lane * UINT8(8))));
+        xorBytes[idx] = UINT8(toggleBits >> (lane * UINT8(8)));
+        if ((andBytes[idx] != UINT8(0xff)) || (xorBytes[idx] != UINT8(0x00))) {
+            first = XCP_MIN(first, idx);
+            last = idx;
+        }
+    }
+    /* Only [MTA + first, MTA + last] has to be accessible. */
+    if (first < UINT8(4)) {
+        mta = Xcp_State.mta;
+        mta.address += UINT32(first);
+        XCP_CHECK_MEMORY_ACCESS(mta, UINT32(last - first) + UINT32(1), XCP_MEM_ACCESS_WRITE, XCP_FALSE);
+        vp = (uint8_t *)Xcp_MapAddress(mta, UINT32(last - first) + UINT32(1));
+        if (vp == (uint8_t *)XCP_NULL) {
+            XCP_ERROR_RESPONSE(ERR_ACCESS_DENIED);
+            return;
+        }
+        Xcp_MemModify(vp, andBytes + first, xorBytes + first, UINT8(UINT8(last - first) + UINT8(1)));
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+        Xcp_ChecksumMarkDirty((uint8_t const *)vp, UINT32(last - first) + UINT32(1));
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+    }
 
     XCP_POSITIVE_RESPONSE();
 }
@@ -1240,6 +1642,159 @@ static void Xcp_ModifyBits_Res(Xcp_PDUType const * const pdu)
 #endif // XCP_ENABLE_CAL_COMMANDS
 
 
+/*
+**
+**  Page Switching Commands.
+**
+*/
+#if XCP_ENABLE_PAG_COMMANDS == XCP_ON
+static void Xcp_SetCalPage_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t mode = Xcp_GetByte(pdu, UINT8(1));
+    uint8_t segment = Xcp_GetByte(pdu, UINT8(2));
+    uint8_t page = Xcp_GetByte(pdu, UINT8(3));
+
+    XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+    DBG_PRINT4("SET_CAL_PAGE [mode: 0x%02x segment: %u page: %u]\n", mode, segment, page);
+
+    Xcp_SendResult(XcpPag_SetCalPage(segment, page, mode));
+}
+
+static void Xcp_GetCalPage_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t mode = Xcp_GetByte(pdu, UINT8(1));
+    uint8_t segment = Xcp_GetByte(pdu, UINT8(2));
+    uint8_t page = UINT8(0);
+    Xcp_ReturnType result;
+
+    XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+    DBG_PRINT3("GET_CAL_PAGE [mode: 0x%02x segment: %u]\n", mode, segment);
+
+    result = XcpPag_GetCalPage(segment, mode, &page);
+    if (result != ERR_SUCCESS) {
+        Xcp_SendResult(result);
+        return;
+    }
+    Xcp_Send8(UINT8(4), UINT8(0xff), UINT8(0), UINT8(0), page, UINT8(0), UINT8(0), UINT8(0), UINT8(0));
+}
+
+#if XCP_ENABLE_GET_PAG_PROCESSOR_INFO == XCP_ON
+static void Xcp_GetPagProcessorInfo_Res(Xcp_PDUType const * const pdu)
+{
+    XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+    DBG_PRINT1("GET_PAG_PROCESSOR_INFO\n");
+
+    /* No STORE_CAL_REQ, so FREEZE_SUPPORTED stays clear. */
+    Xcp_Send8(UINT8(3), UINT8(0xff), UINT8(XCP_PAG_SEGMENTS), UINT8(0), UINT8(0), UINT8(0), UINT8(0), UINT8(0), UINT8(0));
+}
+#endif // XCP_ENABLE_GET_PAG_PROCESSOR_INFO
+
+#if XCP_ENABLE_GET_SEGMENT_INFO == XCP_ON
+static void Xcp_GetSegmentInfo_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t mode = Xcp_GetByte(pdu, UINT8(1));
+    uint8_t segmentNumber = Xcp_GetByte(pdu, UINT8(2));
+    uint8_t info = Xcp_GetByte(pdu, UINT8(3));
+    Xcp_PagSegmentType const * segment;
+    uint32_t value;
+
+    XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+    DBG_PRINT4("GET_SEGMENT_INFO [mode: %u segment: %u info: %u]\n", mode, segmentNumber, info);
+
+    if (segmentNumber >= UINT8(XCP_PAG_SEGMENTS)) {
+        XCP_ERROR_RESPONSE(ERR_SEGMENT_NOT_VALID);
+        return;
+    }
+    segment = &Xcp_PagSegments[segmentNumber];
+    if (mode == UINT8(1)) {
+        /* Standard info: no address mappings, compression or encryption. */
+        Xcp_Send8(UINT8(6), UINT8(0xff), segment->pageCount, segment->ext, UINT8(0), UINT8(0), UINT8(0), UINT8(0), UINT8(0));
+        return;
+    }
+    if ((mode != UINT8(0)) || (info > UINT8(1))) {
+        XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+        return;
+    }
+    value = (info == UINT8(0)) ? segment->address : segment->length;
+    Xcp_Send8(UINT8(8), UINT8(0xff),
+        UINT8(0), UINT8(0), UINT8(0),
+        XCP_LOBYTE(XCP_LOWORD(value)), XCP_HIBYTE(XCP_LOWORD(value)), XCP_LOBYTE(XCP_HIWORD(value)), XCP_HIBYTE(XCP_HIWORD(value))
+    );
+}
+#endif // XCP_ENABLE_GET_SEGMENT_INFO
+
+#if XCP_ENABLE_GET_PAGE_INFO == XCP_ON
+static void Xcp_GetPageInfo_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t segment = Xcp_GetByte(pdu, UINT8(2));
+    uint8_t page = Xcp_GetByte(pdu, UINT8(3));
+
+    XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+    DBG_PRINT3("GET_PAGE_INFO [segment: %u page: %u]\n", segment, page);
+
+    if (segment >= UINT8(XCP_PAG_SEGMENTS)) {
+        XCP_ERROR_RESPONSE(ERR_SEGMENT_NOT_VALID);
+        return;
+    }
+    if (page >= Xcp_PagSegments[segment].pageCount) {
+        XCP_ERROR_RESPONSE(ERR_PAGE_NOT_VALID);
+        return;
+    }
+    Xcp_Send8(UINT8(3), UINT8(0xff), Xcp_PagSegments[segment].pages[page].properties, segment,
+        UINT8(0), UINT8(0), UINT8(0), UINT8(0), UINT8(0)
+    );
+}
+#endif // XCP_ENABLE_GET_PAGE_INFO
+
+#if XCP_ENABLE_SET_SEGMENT_MODE == XCP_ON
+static void Xcp_SetSegmentMode_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t mode = Xcp_GetByte(pdu, UINT8(1));
+    uint8_t segment = Xcp_GetByte(pdu, UINT8(2));
+
+    XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+    DBG_PRINT3("SET_SEGMENT_MODE [mode: 0x%02x segment: %u]\n", mode, segment);
+
+    Xcp_SendResult(XcpPag_SetSegmentMode(segment, mode));
+}
+#endif // XCP_ENABLE_SET_SEGMENT_MODE
+
+#if XCP_ENABLE_GET_SEGMENT_MODE == XCP_ON
+static void Xcp_GetSegmentMode_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t segment = Xcp_GetByte(pdu, UINT8(2));
+    uint8_t mode = UINT8(0);
+    Xcp_ReturnType result;
+
+    XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+    DBG_PRINT2("GET_SEGMENT_MODE [segment: %u]\n", segment);
+
+    result = XcpPag_GetSegmentMode(segment, &mode);
+    if (result != ERR_SUCCESS) {
+        Xcp_SendResult(result);
+        return;
+    }
+    Xcp_Send8(UINT8(3), UINT8(0xff), UINT8(0), mode, UINT8(0), UINT8(0), UINT8(0), UINT8(0), UINT8(0));
+}
+#endif // XCP_ENABLE_GET_SEGMENT_MODE
+
+#if XCP_ENABLE_COPY_CAL_PAGE == XCP_ON
+static void Xcp_CopyCalPage_Res(Xcp_PDUType const * const pdu)
+{
+    uint8_t srcSegment = Xcp_GetByte(pdu, UINT8(1));
+    uint8_t srcPage = Xcp_GetByte(pdu, UINT8(2));
+    uint8_t dstSegment = Xcp_GetByte(pdu, UINT8(3));
+    uint8_t dstPage = Xcp_GetByte(pdu, UINT8(4));
+
+    XCP_ASSERT_UNLOCKED(XCP_RESOURCE_CAL_PAG);
+    DBG_PRINT5("COPY_CAL_PAGE [%u:%u --> %u:%u]\n", srcSegment, srcPage, dstSegment, dstPage);
+
+    Xcp_SendResult(XcpPag_CopyCalPage(srcSegment, srcPage, dstSegment, dstPage));
+}
+#endif // XCP_ENABLE_COPY_CAL_PAGE
+#endif // XCP_ENABLE_PAG_COMMANDS
+
+
 /*
 **
 **  DAQ Commands.
@@ -1267,8 +1822,12 @@ entries will be reset to address=0, extension=0 and size=0 (if valid : bit_offse
 PREDEFINED and configurable DAQ lists, the running Data Transmission on this list will be
 stopped and all DAQ list states are reset.
 #endif // 0
+    if (daqListNumber >= XcpDaq_GetListCount()) {
+        XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+        return;
+    }
+    XcpDaq_ClearList(daqListNumber);
     XCP_POSITIVE_RESPONSE();
-
 }
 
 static void Xcp_SetDaqPtr_Res(Xcp_PDUType const * const pdu)
@@ -1300,20 +1859,40 @@ static void Xcp_SetDaqPtr_Res(Xcp_PDUType const * const pdu)
 static void Xcp_WriteDaq_Res(Xcp_PDUType const * const pdu)
 {
     XcpDaq_ODTEntryType * entry;
+    XcpDaq_ListType const * list;
+    Xcp_MtaType mta;
+    Xcp_MemoryAccessType access;
+    uint8_t fingerprint[3];
     const uint8_t bitOffset = Xcp_GetByte(pdu, UINT8(1));
     const uint8_t elemSize  = Xcp_GetByte(pdu, UINT8(2));
     const uint8_t adddrExt  = Xcp_GetByte(pdu, UINT8(3));
     const uint32_t address  = Xcp_GetDWord(pdu, UINT8(4));
 
     XCP_ASSERT_UNLOCKED(XCP_RESOURCE_DAQ);
-    entry = XcpDaq_GetOdtEntry(Xcp_State.daqPointer.daqList, Xcp_State.daqPointer.odt, Xcp_State.daqPointer.odtEntry);
 
     DBG_PRINT5("WRITE_DAQ [address: 0x%08x ext: 0x%02x size: %u offset: %u]\n", address, adddrExt, elemSize, bitOffset);
 
+    if (!XcpDaq_ValidateOdtEntry(Xcp_State.daqPointer.daqList, Xcp_State.daqPointer.odt, Xcp_State.daqPointer.odtEntry)) {
+        XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+        return;
+    }
+    list = XcpDaq_GetList(Xcp_State.daqPointer.daqList);
+    entry = XcpDaq_GetOdtEntry(Xcp_State.daqPointer.daqList, Xcp_State.daqPointer.odt, Xcp_State.daqPointer.odtEntry);
+
+    /* Reject bad addresses here, not while sampling. */
+    mta.address = address;
+    mta.ext = adddrExt;
+    access = ((list->mode & XCP_DAQ_LIST_MODE_DIRECTION) == XCP_DAQ_LIST_MODE_DIRECTION) ? XCP_MEM_ACCESS_WRITE : XCP_MEM_ACCESS_READ;
+    if (!Xcp_CheckMemoryAccess(mta, UINT32(elemSize), access, (bool)XCP_FALSE)) {
+        XCP_ERROR_RESPONSE(ERR_ACCESS_DENIED);
+        return;
+    }
+
 #if XCP_DAQ_BIT_OFFSET_SUPPORTED == XCP_ON
     entry->bitOffset = bitOffset;
 #endif // XCP_DAQ_BIT_OFFSET_SUPPORTED
     entry->length = elemSize;
+    entry->epoch = list->epoch;
     entry->mta.address = address;
 #if XCP_DAQ_ADDR_EXT_SUPPORTED == XCP_ON
     entry->mta.ext = adddrExt;
@@ -1321,7 +1900,13 @@ static void Xcp_WriteDaq_Res(Xcp_PDUType const * const pdu)
 
     // Advance ODT entry pointer within  one  and  the same ODT. After writing to the
     // last ODT entry of an ODT, the value of the DAQ pointer is undefined!
+    fingerprint[0] = UINT8(Xcp_State.daqPointer.daqList);
+    fingerprint[1] = UINT8(Xcp_State.daqPointer.odt);
+    fingerprint[2] = UINT8(Xcp_State.daqPointer.odtEntry);
+    XcpDaq_AddToFingerprint(fingerprint, UINT16(3));
+    XcpDaq_AddToFingerprint(pdu->data, UINT16(8));
     Xcp_State.daqPointer.odtEntry += (XcpDaq_ODTEntryIntegerType)1;
+    XcpDaq_InvalidateGatherPlan();
 
     XCP_POSITIVE_RESPONSE();
 }
@@ -1329,6 +1914,7 @@ static void Xcp_WriteDaq_Res(Xcp_PDUType const * const pdu)
 static void Xcp_SetDaqListMode_Res(Xcp_PDUType const * const pdu)
 {
     XcpDaq_ListType * entry;
+    uint8_t fingerprint[4];
     const uint8_t mode = Xcp_GetByte(pdu, UINT8(1));
     const XcpDaq_ListIntegerType daqListNumber = (XcpDaq_ListIntegerType)Xcp_GetWord(pdu, UINT8(2));
     const uint16_t eventChannelNumber = Xcp_GetWord(pdu, UINT8(4));
@@ -1382,6 +1968,16 @@ The master is not allowed to set the ALTERNATING flag and the TIMESTAMP flag at
 #if XCP_DAQ_PRESCALER_SUPPORTED == XCP_ON
     entry->prescaler = prescaler;
 #endif // XCP_DAQ_PRESCALER_SUPPORTED
+    entry->eventChannel = eventChannelNumber;
+    entry->priority = priority;
+
+    /* Only the bits that shape the gather plan are part of the configuration fingerprint. */
+    fingerprint[0] = UINT8(XCP_SET_DAQ_LIST_MODE);
+    fingerprint[1] = XCP_LOBYTE(daqListNumber);
+    fingerprint[2] = XCP_HIBYTE(daqListNumber);
+    fingerprint[3] = UINT8(mode & (XCP_DAQ_LIST_MODE_DIRECTION | XCP_DAQ_LIST_MODE_TIMESTAMP | XCP_DAQ_LIST_MODE_PID_OFF));
+    XcpDaq_AddToFingerprint(fingerprint, UINT16(4));
+    XcpDaq_InvalidateGatherPlan();
 
     XCP_POSITIVE_RESPONSE();
 }
@@ -1389,6 +1985,7 @@ The master is not allowed to set the ALTERNATING flag and the TIMESTAMP flag at
 static void Xcp_StartStopDaqList_Res(Xcp_PDUType const * const pdu)
 {
     XcpDaq_ListType * entry;
+    Xcp_ReturnType result;
     const uint8_t mode = Xcp_GetByte(pdu, UINT8(1));
     const XcpDaq_ListIntegerType daqListNumber = (XcpDaq_ListIntegerType)Xcp_GetWord(pdu, UINT8(2));
 #if 0
@@ -1401,20 +1998,27 @@ static void Xcp_StartStopDaqList_Res(Xcp_PDUType const * const pdu)
 
     DBG_PRINT3("START_STOP_DAQ_LIST [mode: 0x%02x daq: %03u]\n", mode, daqListNumber);
     XCP_ASSERT_UNLOCKED(XCP_RESOURCE_DAQ);
+    if (daqListNumber >= XcpDaq_GetListCount()) {
+        XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+        return;
+    }
     entry = XcpDaq_GetList(daqListNumber);
 
     if (mode == 0) {
-
+        XcpDaq_StopList(daqListNumber);
     } else if (mode == 1) {
-
+        result = XcpDaq_StartList(daqListNumber);
+        if (result != ERR_SUCCESS) {
+            Xcp_SendResult(result);
+            return;
+        }
     } else if (mode == 2) {
-        entry->mode = XCP_DAQ_LIST_MODE_SELECTED;
+        entry->mode |= XCP_DAQ_LIST_MODE_SELECTED;
     } else {
         XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
         return;
     }
 
-
 #if 0
 Positive Response:
 
@@ -1422,18 +2026,23 @@ Position  Type  Description
 0  BYTE  Packet ID: 0xFF
 1  BYTE  FIRST_PID
 #endif // 0
-    XCP_POSITIVE_RESPONSE();
+    Xcp_Send8(UINT8(2), UINT8(0xff), XcpDaq_GetFirstPid(daqListNumber), UINT8(0), UINT8(0), UINT8(0), UINT8(0), UINT8(0), UINT8(0));
 }
 
 static void Xcp_StartStopSynch_Res(Xcp_PDUType const * const pdu)
 {
     const uint8_t mode = Xcp_GetByte(pdu, UINT8(1));
+    Xcp_ReturnType result;
 
     DBG_PRINT2("START_STOP_SYNCH [mode: 0x%02x]\n", mode);
     XCP_ASSERT_UNLOCKED(XCP_RESOURCE_DAQ);
 
     if (mode == START_SELECTED) {
-        XcpDaq_StartSelectedLists();
+        result = XcpDaq_StartSelectedLists();
+        if (result != ERR_SUCCESS) {
+            Xcp_SendResult(result);
+            return;
+        }
         XcpDaq_SetProcessorState(XCP_DAQ_STATE_RUNNING);
     } else if (mode == STOP_ALL) {
         XcpDaq_StopAllLists();
@@ -1449,9 +2058,28 @@ static void Xcp_StartStopSynch_Res(Xcp_PDUType const * const pdu)
 
 static void Xcp_GetDaqListMode_Res(Xcp_PDUType const * const pdu)
 {
-    DBG_PRINT1("GET_DAQ_LIST_MODE\n");
+    XcpDaq_ListType const * entry;
+    const XcpDaq_ListIntegerType daqListNumber = (XcpDaq_ListIntegerType)Xcp_GetWord(pdu, UINT8(2));
+
+    DBG_PRINT2("GET_DAQ_LIST_MODE [daq: %u]\n", daqListNumber);
     XCP_ASSERT_UNLOCKED(XCP_RESOURCE_DAQ);
-    XCP_POSITIVE_RESPONSE();
+    if (daqListNumber >= XcpDaq_GetListCount()) {
+        XCP_ERROR_RESPONSE(ERR_OUT_OF_RANGE);
+        return;
+    }
+    entry = XcpDaq_GetList(daqListNumber);
+
+    Xcp_Send8(UINT8(8), UINT8(0xff),
+        entry->mode,
+        UINT8(0), UINT8(0),  // Reserved
+        XCP_LOBYTE(entry->eventChannel), XCP_HIBYTE(entry->eventChannel),
+#if XCP_DAQ_PRESCALER_SUPPORTED == XCP_ON
+        entry->prescaler,
+#else
+        UINT8(1),
+#endif // XCP_DAQ_PRESCALER_SUPPORTED
+        entry->priority
+    );
 }
 
 
@@ -1610,6 +2238,19 @@ static void Xcp_SendResult(Xcp_ReturnType result)
     }
 }
 
+static void Xcp_SendFrame(uint8_t * frame, uint16_t len)
+{
+    frame[0] = XCP_LOBYTE(len);
+    frame[1] = XCP_HIBYTE(len);
+#if XCP_TRANSPORT_LAYER_COUNTER_SIZE != 0
+    frame[2] = XCP_LOBYTE(Xcp_State.counter);
+    frame[3] = XCP_HIBYTE(Xcp_State.counter);
+    Xcp_State.counter++;
+#endif // XCP_TRANSPORT_LAYER_COUNTER_SIZE
+
+    XcpTl_Send(frame, len + (uint16_t)4);
+}
+
 #if 0
 void Xcp_DumpMessageObject(Xcp_PDUType const * pdu)
 {
@@ -1628,16 +2269,21 @@ void Xcp_WriteMemory(void * dest, void * src, uint16_t count)
     Xcp_MemCopy(dest, src, UINT32(count));
 }
 
-void Xcp_CopyMemory(Xcp_MtaType dst, Xcp_MtaType src, uint32_t len)
+/**
+ * Copy `len` bytes between two MTAs.
+ *
+ * @return ERR_ACCESS_DENIED if either range isn't mapped; nothing is copied then.
+ */
+Xcp_ReturnType Xcp_CopyMemory(Xcp_MtaType dst, Xcp_MtaType src, uint32_t len)
 {
-    // TODO: AddressMapper!!!
-    if ((dst.ext == (uint8_t)0) && (src.ext == (uint8_t)0)) {
-//        DBG_PRINT2("LEN: %u\n", len);
-//        DBG_PRINT3("dst: %08X src: %08x\n", dst.address, src.address);
-        Xcp_MemCopy((void*)dst.address, (void*)src.address, len);
-    } else {
-        // We need assistance...
+    uint8_t * pd = Xcp_MapAddress(dst, len);
+    uint8_t * ps = Xcp_MapAddress(src, len);
+
+    if ((pd == (uint8_t *)XCP_NULL) || (ps == (uint8_t *)XCP_NULL)) {
+        return ERR_ACCESS_DENIED;
     }
+    Xcp_MemCopy(pd, ps, len);
+    return ERR_SUCCESS;
 }
 
 INLINE uint8_t Xcp_GetByte(Xcp_PDUType const * const pdu, uint8_t offs)
@@ -1716,3 +2362,243 @@ Xcp_StateType const * Xcp_GetState(void)
 {
     return &Xcp_State;
 }
+
+/**
+ * Range-check a memory access of `length` bytes starting at `mta`.
+ *
+ * A range within one region of Xcp_MemoryRegions[] is decided by the access
+ * rights of the region, a range overlapping any region otherwise is denied.
+ * Ranges touching no region are left to the user hook, if enabled, which
+ * only sees single addresses, so the first and the last byte of the range
+ * are checked.
+ */
+bool Xcp_CheckMemoryAccess(Xcp_MtaType mta, uint32_t length, Xcp_MemoryAccessType access, bool programming)
+{
+#if (XCP_ENABLE_CHECK_MEMORY_ACCESS == XCP_ON) || (XCP_MEMORY_REGIONS > 0)
+    Xcp_MtaType last;
+#if XCP_MEMORY_REGIONS > 0
+    Xcp_MemoryRegionType const * region;
+    uint8_t required;
+    uint64_t start;
+#endif // XCP_MEMORY_REGIONS
+
+    if (length == UINT32(0)) {
+        return (bool)XCP_TRUE;
+    }
+    last = mta;
+    last.address += (length - UINT32(1));
+    if (last.address < mta.address) {
+        return (bool)XCP_FALSE; /* Wrap-around. */
+    }
+#if XCP_MEMORY_REGIONS > 0
+    region = Xcp_FindMemoryRegion(mta);
+    if ((region->ext == mta.ext) && (mta.address >= region->address) && ((mta.address - region->address) < region->length)) {
+        if ((last.address - region->address) >= region->length) {
+            return (bool)XCP_FALSE; /* Runs past the end of the region. */
+        }
+        if (access == XCP_MEM_ACCESS_READ) {
+            required = XCP_MEMORY_REGION_READ;
+        } else {
+            required = programming ? XCP_MEMORY_REGION_PROGRAM : XCP_MEMORY_REGION_WRITE;
+        }
+        return (bool)((region->access & required) == required);
+    }
+    /* Starts outside of all regions: denied if a region starts within the range. */
+    region = Xcp_FindMemoryRegion(last);
+    start = (UINT64(region->ext) << 32) | UINT64(region->address);
+    if ((start > ((UINT64(mta.ext) << 32) | UINT64(mta.address))) && (start <= ((UINT64(last.ext) << 32) | UINT64(last.address)))) {
+        return (bool)XCP_FALSE;
+    }
+#endif // XCP_MEMORY_REGIONS
+#if XCP_ENABLE_CHECK_MEMORY_ACCESS == XCP_ON
+    if (!Xcp_HookFunction_CheckMemoryAccess(mta, access, programming)) {
+        return (bool)XCP_FALSE;
+    }
+    return Xcp_HookFunction_CheckMemoryAccess(last, access, programming);
+#else
+    return (bool)XCP_FALSE;
+#endif // XCP_ENABLE_CHECK_MEMORY_ACCESS
+#else
+    return (bool)XCP_TRUE;
+#endif // XCP_ENABLE_CHECK_MEMORY_ACCESS || XCP_MEMORY_REGIONS
+}
+
+/**
+ * `mta` lies within a region flagged XCP_MEMORY_REGION_DEVICE (s. Xcp_MemoryRegions[]).
+ */
+bool Xcp_IsDeviceMemory(Xcp_MtaType mta)
+{
+#if XCP_MEMORY_REGIONS > 0
+    Xcp_MemoryRegionType const * region = Xcp_FindMemoryRegion(mta);
+
+    return (bool)((region->ext == mta.ext) && (mta.address >= region->address) &&
+                  ((mta.address - region->address) < region->length) &&
+                  ((region->access & XCP_MEMORY_REGION_DEVICE) == XCP_MEMORY_REGION_DEVICE));
+#else
+    (void)mta;
+    return (bool)XCP_FALSE;
+#endif // XCP_MEMORY_REGIONS
+}
+
+#if XCP_MEMORY_REGIONS > 0
+/*
+**  Last region starting at or below `mta` (resp. the first region), the loop
+**  runs log2(XCP_MEMORY_REGIONS) times and compiles to conditional moves.
+*/
+static Xcp_MemoryRegionType const * Xcp_FindMemoryRegion(Xcp_MtaType mta)
+{
+    Xcp_MemoryRegionType const * base = &Xcp_MemoryRegions[0];
+    uint16_t count = UINT16(XCP_MEMORY_REGIONS);
+    uint16_t half;
+    uint64_t const key = (UINT64(mta.ext) << 32) | UINT64(mta.address);
+
+    while (count > UINT16(1)) {
+        half = count / UINT16(2);
+        base = (((UINT64(base[half].ext) << 32) | UINT64(base[half].address)) <= key) ? &base[half] : base;
+        count -= half;
+    }
+    return base;
+}
+#endif // XCP_MEMORY_REGIONS
+
+/**
+ * Translate `length` bytes at `mta` (A2L address space) to a host pointer.
+ *
+ * With the address mapper the range has to lie within one mapping (s.
+ * Xcp_AddressMapperRegister()), unmapped extension 0 addresses are taken as
+ * pointers only where pointers are 32 bits wide. Without it, extension 0
+ * addresses are always pointers.
+ *
+ * @return Host pointer or XCP_NULL if the range isn't accessible.
+ */
+uint8_t * Xcp_MapAddress(Xcp_MtaType mta, uint32_t length)
+{
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+    uint8_t low = UINT8(0);
+    uint8_t high = Xcp_AddressMappingCount;
+    uint8_t mid;
+#endif // XCP_ENABLE_ADDRESS_MAPPER
+#if (XCP_ENABLE_ADDRESS_MAPPER == XCP_ON) || (XCP_ENABLE_PAG_COMMANDS == XCP_ON)
+    uint8_t * result;
+#endif
+
+#if XCP_ENABLE_PAG_COMMANDS == XCP_ON
+    result = XcpPag_MapAddress(mta, length);    /* Calibration segments: the XCP page. */
+    if (result != (uint8_t *)XCP_NULL) {
+        return result;
+    }
+#endif // XCP_ENABLE_PAG_COMMANDS
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+    if (Xcp_AddressMappingLastHit < Xcp_AddressMappingCount) {
+        result = Xcp_AddressMappingResolve(&Xcp_AddressMappings[Xcp_AddressMappingLastHit], mta, length);
+        if (result != (uint8_t *)XCP_NULL) {
+            return result;
+        }
+    }
+    /* Last mapping starting at or below ext:address. */
+    while (low < high) {
+        mid = UINT8(low + ((high - low) / UINT8(2)));
+        if (Xcp_AddressMappingLess(mta.ext, mta.address, &Xcp_AddressMappings[mid])) {
+            high = mid;
+        } else {
+            low = UINT8(mid + UINT8(1));
+        }
+    }
+    if (low > UINT8(0)) {
+        result = Xcp_AddressMappingResolve(&Xcp_AddressMappings[low - UINT8(1)], mta, length);
+        if (result != (uint8_t *)XCP_NULL) {
+            Xcp_AddressMappingLastHit = UINT8(low - UINT8(1));
+            return result;
+        }
+    }
+    if (sizeof(void *) > sizeof(uint32_t)) {
+        return (uint8_t *)XCP_NULL; /* A2L addresses can't be pointers. */
+    }
+#endif // XCP_ENABLE_ADDRESS_MAPPER
+    (void)length;
+    if (mta.ext == UINT8(0)) {
+        return (uint8_t *)(uintptr_t)mta.address;
+    }
+    return (uint8_t *)XCP_NULL;
+}
+
+#if XCP_ENABLE_ADDRESS_MAPPER == XCP_ON
+/**
+ * Make `length` bytes at `host` accessible as `ext`:`address`.
+ *
+ * @return XCP_FALSE if the table is full or the range overlaps another mapping.
+ */
+bool Xcp_AddressMapperRegister(uint8_t ext, uint32_t address, uint32_t length, void * host)
+{
+    uint8_t pos = UINT8(0);
+    uint8_t idx;
+    Xcp_AddressMappingType const * next;
+    Xcp_AddressMappingType const * previous;
+
+    if ((length == UINT32(0)) || ((address + (length - UINT32(1))) < address)) {
+        return (bool)XCP_FALSE;
+    }
+    while ((pos < Xcp_AddressMappingCount) && !Xcp_AddressMappingLess(ext, address, &Xcp_AddressMappings[pos])) {
+        ++pos;
+    }
+    if (pos > UINT8(0)) {
+        previous = &Xcp_AddressMappings[pos - UINT8(1)];
+        if ((previous->ext == ext) && (previous->address == address) && (previous->length == length) && (previous->host == (uint8_t *)host)) {
+            return (bool)XCP_TRUE;  /* Already registered. */
+        }
+        if ((previous->ext == ext) && ((address - previous->address) < previous->length)) {
+            return (bool)XCP_FALSE;
+        }
+    }
+    if (pos < Xcp_AddressMappingCount) {
+        next = &Xcp_AddressMappings[pos];
+        if ((next->ext == ext) && ((next->address - address) < length)) {
+            return (bool)XCP_FALSE;
+        }
+    }
+    if (Xcp_AddressMappingCount == UINT8(XCP_ADDRESS_MAPPER_ENTRIES)) {
+        return (bool)XCP_FALSE;
+    }
+    for (idx = Xcp_AddressMappingCount; idx > pos; --idx) {
+        Xcp_AddressMappings[idx] = Xcp_AddressMappings[idx - UINT8(1)];
+    }
+    Xcp_AddressMappings[pos].ext = ext;
+    Xcp_AddressMappings[pos].address = address;
+    Xcp_AddressMappings[pos].length = length;
+    Xcp_AddressMappings[pos].host = (uint8_t *)host;
+    Xcp_AddressMappingCount++;
+    Xcp_AddressMappingLastHit = UINT8(0);
+#if XCP_ENABLE_DAQ_COMMANDS == XCP_ON
+    XcpDaq_FlushGatherPlans();
+#endif // XCP_ENABLE_DAQ_COMMANDS
+    return (bool)XCP_TRUE;
+}
+
+void Xcp_AddressMapperClear(void)
+{
+    Xcp_AddressMappingCount = UINT8(0);
+    Xcp_AddressMappingLastHit = UINT8(0);
+#if XCP_ENABLE_DAQ_COMMANDS == XCP_ON
+    XcpDaq_FlushGatherPlans();
+#endif // XCP_ENABLE_DAQ_COMMANDS
+}
+
+static bool Xcp_AddressMappingLess(uint8_t ext, uint32_t address, Xcp_AddressMappingType const * mapping)
+{
+    return (bool)((ext < mapping->ext) || ((ext == mapping->ext) && (address < mapping->address)));
+}
+
+static uint8_t * Xcp_AddressMappingResolve(Xcp_AddressMappingType const * mapping, Xcp_MtaType mta, uint32_t length)
+{
+    uint32_t offset;
+
+    if ((mta.ext != mapping->ext) || (mta.address < mapping->address)) {
+        return (uint8_t *)XCP_NULL;
+    }
+    offset = mta.address - mapping->address;
+    if ((offset >= mapping->length) || (length > (mapping->length - offset))) {
+        return (uint8_t *)XCP_NULL;
+    }
+    return mapping->host + offset;
+}
+#endif // XCP_ENABLE_ADDRESS_MAPPER
@@ -0,0 +1,237 @@
+/*
+ * BlueParrot XCP
+ *
+ * (C) 2007-2019 by Christoph Schueler <github.com/Christoph2,
+ *                                      cpu12.gems@googlemail.com>
+ *
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * s. FLOSS-EXCEPTION.txt
+ */
+
+#include "xcp.h"
+#include "xcp_util.h"
+
+#if XCP_CAL_STAGING_SIZE > 0
+
+/*
+** Local Types.
+*/
+
+/*
+**  A transaction is a log of writes, each a header followed by its data:
+**  nothing reaches target memory before the whole log is applied.
+*/
+typedef struct tagXcpCal_StagedWriteType {
+    uint8_t * destination;
+    uint16_t length;
+    bool device;            /* s. XCP_MEMORY_REGION_DEVICE */
+} XcpCal_StagedWriteType;
+
+typedef struct tagXcpCal_LogType {
+    uint16_t used;
+    uint8_t data[XCP_CAL_STAGING_SIZE];
+} XcpCal_LogType;
+
+#define XCP_CAL_NO_LOG  UINT8(0xff)
+
+
+/*
+** Local Variables.
+*/
+
+/*
+**  One log is filled by XCP while the other may wait for the commit event,
+**  so a new transaction can begin before the previous one is applied.
+*/
+static XcpCal_LogType XcpCal_Logs[2];
+static uint8_t XcpCal_OpenLog;                  /* Receives staged writes. */
+static uint8_t volatile XcpCal_CommittedLog;    /* Waits for the commit event. */
+
+
+/*
+** Local Function Prototypes.
+*/
+static void XcpCal_Apply(uint8_t logIdx);
+
+
+/*
+** Global Functions.
+*/
+void XcpCal_Init(void)
+{
+    XCP_CAL_ENTER_CRITICAL();
+    XcpCal_OpenLog = XCP_CAL_NO_LOG;
+    XcpCal_CommittedLog = XCP_CAL_NO_LOG;
+    XCP_CAL_LEAVE_CRITICAL();
+}
+
+Xcp_ReturnType XcpCal_Begin(void)
+{
+    uint8_t logIdx;
+
+    if (XcpCal_OpenLog != XCP_CAL_NO_LOG) {
+        return ERR_SEQUENCE;
+    }
+    XCP_CAL_ENTER_CRITICAL();
+    logIdx = (XcpCal_CommittedLog == UINT8(0)) ? UINT8(1) : UINT8(0);
+    XCP_CAL_LEAVE_CRITICAL();
+    XcpCal_Logs[logIdx].used = UINT16(0);
+    XcpCal_OpenLog = logIdx;
+    return ERR_SUCCESS;
+}
+
+/**
+ * Close the open transaction. It is applied by the next
+ * XcpCal_TriggerEvent(XCP_CAL_COMMIT_EVENT), or right away if
+ * XCP_CAL_COMMIT_ON_EVENT is off (ERR_CMD_BUSY while a BUILD_CHECKSUM is
+ * calculated in the background).
+ */
+Xcp_ReturnType XcpCal_Commit(void)
+{
+    uint8_t const logIdx = XcpCal_OpenLog;
+
+    if (logIdx == XCP_CAL_NO_LOG) {
+        return ERR_SEQUENCE;
+    }
+#if XCP_CAL_COMMIT_ON_EVENT == XCP_ON
+    XCP_CAL_ENTER_CRITICAL();
+    if (XcpCal_CommittedLog != XCP_CAL_NO_LOG) {
+        XCP_CAL_LEAVE_CRITICAL();
+        return ERR_CMD_BUSY;    /* Previous transaction not yet applied. */
+    }
+    XcpCal_CommittedLog = logIdx;
+    XCP_CAL_LEAVE_CRITICAL();
+#else
+#if (XCP_ENABLE_BUILD_CHECKSUM == XCP_ON) && (XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON)
+    if (Xcp_ChecksumIsPending()) {
+        return ERR_CMD_BUSY;
+    }
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+    XCP_CAL_ENTER_CRITICAL();
+    XcpCal_Apply(logIdx);
+    XCP_CAL_LEAVE_CRITICAL();
+#endif // XCP_CAL_COMMIT_ON_EVENT
+    XcpCal_OpenLog = XCP_CAL_NO_LOG;
+    return ERR_SUCCESS;
+}
+
+void XcpCal_Abort(void)
+{
+    XcpCal_OpenLog = XCP_CAL_NO_LOG;
+}
+
+bool XcpCal_IsStaging(void)
+{
+    return (XcpCal_OpenLog != XCP_CAL_NO_LOG) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+}
+
+/**
+ * A transaction is open or waits for its commit event. Staged writes hold
+ * host pointers, so calibration pages must not be switched or moved meanwhile.
+ */
+bool XcpCal_IsPending(void)
+{
+    return ((XcpCal_OpenLog != XCP_CAL_NO_LOG) || (XcpCal_CommittedLog != XCP_CAL_NO_LOG)) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+}
+
+/**
+ * Append a write to the open transaction.
+ *
+ * @return ERR_MEMORY_OVERFLOW if the log is full; the transaction stays open.
+ */
+Xcp_ReturnType XcpCal_Stage(uint8_t * dst, uint8_t const * src, uint32_t length, bool device)
+{
+    XcpCal_LogType * log;
+    XcpCal_StagedWriteType header;
+
+    if (XcpCal_OpenLog == XCP_CAL_NO_LOG) {
+        return ERR_SEQUENCE;
+    }
+    log = &XcpCal_Logs[XcpCal_OpenLog];
+    if ((UINT32(XCP_CAL_STAGING_SIZE - log->used) < UINT32(sizeof(XcpCal_StagedWriteType))) ||
+        (length > (UINT32(XCP_CAL_STAGING_SIZE - log->used) - UINT32(sizeof(XcpCal_StagedWriteType))))) {
+        return ERR_MEMORY_OVERFLOW;
+    }
+    header.destination = dst;
+    header.length = UINT16(length);
+    header.device = device;
+    /* Byte-wise, entries are not aligned. */
+    Xcp_MemCopy(log->data + log->used, (void *)&header, UINT32(sizeof(XcpCal_StagedWriteType)));
+    log->used += UINT16(sizeof(XcpCal_StagedWriteType));
+    Xcp_MemCopy(log->data + log->used, (void *)src, length);
+    log->used += UINT16(length);
+    return ERR_SUCCESS;
+}
+
+/**
+ * Called from the task that owns `eventChannelNumber`, between two cycles
+ * (XcpDaq_TriggerEvent() does so); applies a committed transaction at once,
+ * unless a BUILD_CHECKSUM is calculated in the background (deferred to a later
+ * event then).
+ */
+void XcpCal_TriggerEvent(uint8_t eventChannelNumber)
+{
+#if XCP_CAL_COMMIT_ON_EVENT == XCP_ON
+    uint8_t logIdx;
+
+    if ((eventChannelNumber != UINT8(XCP_CAL_COMMIT_EVENT)) || (XcpCal_CommittedLog == XCP_CAL_NO_LOG)) {
+        return;
+    }
+#if (XCP_ENABLE_BUILD_CHECKSUM == XCP_ON) && (XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON)
+    if (Xcp_ChecksumIsPending()) {
+        return;
+    }
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+    XCP_CAL_ENTER_CRITICAL();
+    logIdx = XcpCal_CommittedLog;
+    if (logIdx != XCP_CAL_NO_LOG) {
+        XcpCal_Apply(logIdx);
+        XcpCal_CommittedLog = XCP_CAL_NO_LOG;
+    }
+    XCP_CAL_LEAVE_CRITICAL();
+#else
+    (void)eventChannelNumber;
+#endif // XCP_CAL_COMMIT_ON_EVENT
+}
+
+
+/*
+** Local Functions.
+*/
+
+/*
+**  Replays the log in order; bounded by XCP_CAL_STAGING_SIZE bytes.
+*/
+static void XcpCal_Apply(uint8_t logIdx)
+{
+    XcpCal_LogType const * log = &XcpCal_Logs[logIdx];
+    XcpCal_StagedWriteType header;
+    uint16_t offset = UINT16(0);
+
+    while (offset < log->used) {
+        Xcp_MemCopy((void *)&header, (void *)(log->data + offset), UINT32(sizeof(XcpCal_StagedWriteType)));
+        offset += UINT16(sizeof(XcpCal_StagedWriteType));
+        Xcp_MemTransfer(header.destination, log->data + offset, UINT32(header.length), header.device);
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+        Xcp_ChecksumMarkDirty(header.destination, UINT32(header.length));
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+        offset += header.length;
+    }
+}
+
+#endif // XCP_CAL_STAGING_SIZE
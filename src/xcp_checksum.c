@@ -33,6 +33,10 @@
 
 #include "xcp.h"
 
+#if XCP_CHECKSUM_WORKER_THREAD == XCP_ON
+#include <pthread.h>
+#endif // XCP_CHECKSUM_WORKER_THREAD
+
 
 /*
 ** Local Types
@@ -40,224 +44,926 @@
 typedef enum tagXcp_ChecksumJobStateType {
     XCP_CHECKSUM_STATE_IDLE,
     XCP_CHECKSUM_STATE_RUNNING_INITIAL,
-    XCP_CHECKSUM_STATE_RUNNING_REMAINING,
-    XCP_CHECKSUM_STATE_RUNNING_FINAL
+    XCP_CHECKSUM_STATE_RUNNING_REMAINING
 } Xcp_ChecksumJobStateType;
 
 
 typedef struct tagXcp_ChecksumJobType {
     Xcp_ChecksumJobStateType state;
-    Xcp_MtaType mta;
+    uint8_t const * ptr;
     uint32_t size;
+    uint32_t chunkSize;
     Xcp_ChecksumType interimChecksum;
 } Xcp_ChecksumJobType;
 
 
-#if XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_11
-
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_12
-
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_14
-
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_22
-
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_24
-
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_44
-
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_16
-
-#define XCP_CRC_NAME            "CRC-16"
-#define XCP_CRC_POLYNOMIAL      ((uint16_t)0x8005)
-#define XCP_CRC_INITIAL_VALUE   ((uint16_t)0x0000)
-#define XCP_CRC_FINAL_XOR_VALUE ((uint16_t)0x0000)
-#define REFLECT_DATA            XCP_TRUE
-#define REFLECT_REMAINDER       XCP_TRUE
-#define CHECK_VALUE             ((uint16_t)0xBB3D)
-
-static const uint16_t CRC_TAB[] = {
-    (uint16_t)0x0000, (uint16_t)0x8005, (uint16_t)0x800F, (uint16_t)0x000A, (uint16_t)0x801B, (uint16_t)0x001E, (uint16_t)0x0014, (uint16_t)0x8011,
-    (uint16_t)0x8033, (uint16_t)0x0036, (uint16_t)0x003C, (uint16_t)0x8039, (uint16_t)0x0028, (uint16_t)0x802D, (uint16_t)0x8027, (uint16_t)0x0022,
-    (uint16_t)0x8063, (uint16_t)0x0066, (uint16_t)0x006C, (uint16_t)0x8069, (uint16_t)0x0078, (uint16_t)0x807D, (uint16_t)0x8077, (uint16_t)0x0072,
-    (uint16_t)0x0050, (uint16_t)0x8055, (uint16_t)0x805F, (uint16_t)0x005A, (uint16_t)0x804B, (uint16_t)0x004E, (uint16_t)0x0044, (uint16_t)0x8041,
-    (uint16_t)0x80C3, (uint16_t)0x00C6, (uint16_t)0x00CC, (uint16_t)0x80C9, (uint16_t)0x00D8, (uint16_t)0x80DD, (uint16_t)0x80D7, (uint16_t)0x00D2,
-    (uint16_t)0x00F0, (uint16_t)0x80F5, (uint16_t)0x80FF, (uint16_t)0x00FA, (uint16_t)0x80EB, (uint16_t)0x00EE, (uint16_t)0x00E4, (uint16_t)0x80E1,
-    (uint16_t)0x00A0, (uint16_t)0x80A5, (uint16_t)0x80AF, (uint16_t)0x00AA, (uint16_t)0x80BB, (uint16_t)0x00BE, (uint16_t)0x00B4, (uint16_t)0x80B1,
-    (uint16_t)0x8093, (uint16_t)0x0096, (uint16_t)0x009C, (uint16_t)0x8099, (uint16_t)0x0088, (uint16_t)0x808D, (uint16_t)0x8087, (uint16_t)0x0082,
-    (uint16_t)0x8183, (uint16_t)0x0186, (uint16_t)0x018C, (uint16_t)0x8189, (uint16_t)0x0198, (uint16_t)0x819D, (uint16_t)0x8197, (uint16_t)0x0192,
-    (uint16_t)0x01B0, (uint16_t)0x81B5, (uint16_t)0x81BF, (uint16_t)0x01BA, (uint16_t)0x81AB, (uint16_t)0x01AE, (uint16_t)0x01A4, (uint16_t)0x81A1,
-    (uint16_t)0x01E0, (uint16_t)0x81E5, (uint16_t)0x81EF, (uint16_t)0x01EA, (uint16_t)0x81FB, (uint16_t)0x01FE, (uint16_t)0x01F4, (uint16_t)0x81F1,
-    (uint16_t)0x81D3, (uint16_t)0x01D6, (uint16_t)0x01DC, (uint16_t)0x81D9, (uint16_t)0x01C8, (uint16_t)0x81CD, (uint16_t)0x81C7, (uint16_t)0x01C2,
-    (uint16_t)0x0140, (uint16_t)0x8145, (uint16_t)0x814F, (uint16_t)0x014A, (uint16_t)0x815B, (uint16_t)0x015E, (uint16_t)0x0154, (uint16_t)0x8151,
-    (uint16_t)0x8173, (uint16_t)0x0176, (uint16_t)0x017C, (uint16_t)0x8179, (uint16_t)0x0168, (uint16_t)0x816D, (uint16_t)0x8167, (uint16_t)0x0162,
-    (uint16_t)0x8123, (uint16_t)0x0126, (uint16_t)0x012C, (uint16_t)0x8129, (uint16_t)0x0138, (uint16_t)0x813D, (uint16_t)0x8137, (uint16_t)0x0132,
-    (uint16_t)0x0110, (uint16_t)0x8115, (uint16_t)0x811F, (uint16_t)0x011A, (uint16_t)0x810B, (uint16_t)0x010E, (uint16_t)0x0104, (uint16_t)0x8101,
-    (uint16_t)0x8303, (uint16_t)0x0306, (uint16_t)0x030C, (uint16_t)0x8309, (uint16_t)0x0318, (uint16_t)0x831D, (uint16_t)0x8317, (uint16_t)0x0312,
-    (uint16_t)0x0330, (uint16_t)0x8335, (uint16_t)0x833F, (uint16_t)0x033A, (uint16_t)0x832B, (uint16_t)0x032E, (uint16_t)0x0324, (uint16_t)0x8321,
-    (uint16_t)0x0360, (uint16_t)0x8365, (uint16_t)0x836F, (uint16_t)0x036A, (uint16_t)0x837B, (uint16_t)0x037E, (uint16_t)0x0374, (uint16_t)0x8371,
-    (uint16_t)0x8353, (uint16_t)0x0356, (uint16_t)0x035C, (uint16_t)0x8359, (uint16_t)0x0348, (uint16_t)0x834D, (uint16_t)0x8347, (uint16_t)0x0342,
-    (uint16_t)0x03C0, (uint16_t)0x83C5, (uint16_t)0x83CF, (uint16_t)0x03CA, (uint16_t)0x83DB, (uint16_t)0x03DE, (uint16_t)0x03D4, (uint16_t)0x83D1,
-    (uint16_t)0x83F3, (uint16_t)0x03F6, (uint16_t)0x03FC, (uint16_t)0x83F9, (uint16_t)0x03E8, (uint16_t)0x83ED, (uint16_t)0x83E7, (uint16_t)0x03E2,
-    (uint16_t)0x83A3, (uint16_t)0x03A6, (uint16_t)0x03AC, (uint16_t)0x83A9, (uint16_t)0x03B8, (uint16_t)0x83BD, (uint16_t)0x83B7, (uint16_t)0x03B2,
-    (uint16_t)0x0390, (uint16_t)0x8395, (uint16_t)0x839F, (uint16_t)0x039A, (uint16_t)0x838B, (uint16_t)0x038E, (uint16_t)0x0384, (uint16_t)0x8381,
-    (uint16_t)0x0280, (uint16_t)0x8285, (uint16_t)0x828F, (uint16_t)0x028A, (uint16_t)0x829B, (uint16_t)0x029E, (uint16_t)0x0294, (uint16_t)0x8291,
-    (uint16_t)0x82B3, (uint16_t)0x02B6, (uint16_t)0x02BC, (uint16_t)0x82B9, (uint16_t)0x02A8, (uint16_t)0x82AD, (uint16_t)0x82A7, (uint16_t)0x02A2,
-    (uint16_t)0x82E3, (uint16_t)0x02E6, (uint16_t)0x02EC, (uint16_t)0x82E9, (uint16_t)0x02F8, (uint16_t)0x82FD, (uint16_t)0x82F7, (uint16_t)0x02F2,
-    (uint16_t)0x02D0, (uint16_t)0x82D5, (uint16_t)0x82DF, (uint16_t)0x02DA, (uint16_t)0x82CB, (uint16_t)0x02CE, (uint16_t)0x02C4, (uint16_t)0x82C1,
-    (uint16_t)0x8243, (uint16_t)0x0246, (uint16_t)0x024C, (uint16_t)0x8249, (uint16_t)0x0258, (uint16_t)0x825D, (uint16_t)0x8257, (uint16_t)0x0252,
-    (uint16_t)0x0270, (uint16_t)0x8275, (uint16_t)0x827F, (uint16_t)0x027A, (uint16_t)0x826B, (uint16_t)0x026E, (uint16_t)0x0264, (uint16_t)0x8261,
-    (uint16_t)0x0220, (uint16_t)0x8225, (uint16_t)0x822F, (uint16_t)0x022A, (uint16_t)0x823B, (uint16_t)0x023E, (uint16_t)0x0234, (uint16_t)0x8231,
-    (uint16_t)0x8213, (uint16_t)0x0216, (uint16_t)0x021C, (uint16_t)0x8219, (uint16_t)0x0208, (uint16_t)0x820D, (uint16_t)0x8207, (uint16_t)0x0202,
-};
+#define XCP_CHECKSUM_ADD_METHODS    (XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_ADD_11) | \
+                                     XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_ADD_12) | \
+                                     XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_ADD_14) | \
+                                     XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_ADD_22) | \
+                                     XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_ADD_24) | \
+                                     XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_ADD_44))
+#define XCP_CHECKSUM_CRC_METHODS    (XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_CRC_16) | \
+                                     XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT) | \
+                                     XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_CRC_32))
+
+#if (XCP_CHECKSUM_METHODS_AVAILABLE & XCP_CHECKSUM_ADD_METHODS) != 0
+#define XCP_CHECKSUM_HAS_ADD
+#endif
+#if (XCP_CHECKSUM_METHODS_AVAILABLE & XCP_CHECKSUM_CRC_METHODS) != 0
+#define XCP_CHECKSUM_HAS_CRC
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_USER_DEFINED)
+#define XCP_CHECKSUM_HAS_HASH
+#endif
+
+/*
+**  Slicing-by-8: table[0] is the classic byte-wise table, table[n] holds the
+**  contribution of a byte followed by n zero bytes, so eight bytes are folded
+**  per iteration. Reflected CRCs use pre-reflected tables (LSB first), the
+**  register of non-reflected CRCs is kept left-aligned in 32 bits, so any
+**  width up to 32 bits works without reflecting data or remainder at run-time.
+**  Tables (8 KB per CRC method) are generated by Xcp_ChecksumInit() from the
+**  polynomials in Xcp_ChecksumMethods[].
+*/
+#define XCP_CRC_SLICES  (8)
+
+typedef struct tagXcp_CrcStateType {
+    uint32_t polynomial;                    /* In register bit order. */
+    uint32_t table[XCP_CRC_SLICES][256];
+    uint32_t x2n[32];                       /* x^(2^n) modulo P(x), used to combine CRCs of adjacent blocks. */
+} Xcp_CrcStateType;
+
+typedef struct tagXcp_ChecksumMethodType {
+    uint8_t method;
+    uint8_t elementSize;        /* Bytes per summand, 1 otherwise. */
+    uint8_t granularity;        /* Blocks that are continued resp. combined must be multiples of this. */
+    uint8_t width;              /* Bits. */
+    bool reflected;
+    uint32_t polynomial;        /* Normal (MSB first) notation. */
+    uint32_t initialValue;
+    uint32_t finalXorValue;
+    Xcp_CrcStateType * crc;     /* XCP_NULL for additive checksums. */
+} Xcp_ChecksumMethodType;
 
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT
-
-#define XCP_CRC_NAME            "CRC-CCITT"
-#define XCP_CRC_POLYNOMIAL      ((uint16_t)0x1021)
-#define XCP_CRC_INITIAL_VALUE   ((uint16_t)0xFFFF)
-#define XCP_CRC_FINAL_XOR_VALUE ((uint16_t)0x0000)
-#define REFLECT_DATA            XCP_FALSE
-#define REFLECT_REMAINDER       XCP_FALSE
-#define CHECK_VALUE             ((uint16_t)0x29B1)
-
-static const uint16_t CRC_TAB[] = {
-    (uint16_t)0x0000, (uint16_t)0x1021, (uint16_t)0x2042, (uint16_t)0x3063, (uint16_t)0x4084, (uint16_t)0x50A5, (uint16_t)0x60C6, (uint16_t)0x70E7,
-    (uint16_t)0x8108, (uint16_t)0x9129, (uint16_t)0xA14A, (uint16_t)0xB16B, (uint16_t)0xC18C, (uint16_t)0xD1AD, (uint16_t)0xE1CE, (uint16_t)0xF1EF,
-    (uint16_t)0x1231, (uint16_t)0x0210, (uint16_t)0x3273, (uint16_t)0x2252, (uint16_t)0x52B5, (uint16_t)0x4294, (uint16_t)0x72F7, (uint16_t)0x62D6,
-    (uint16_t)0x9339, (uint16_t)0x8318, (uint16_t)0xB37B, (uint16_t)0xA35A, (uint16_t)0xD3BD, (uint16_t)0xC39C, (uint16_t)0xF3FF, (uint16_t)0xE3DE,
-    (uint16_t)0x2462, (uint16_t)0x3443, (uint16_t)0x0420, (uint16_t)0x1401, (uint16_t)0x64E6, (uint16_t)0x74C7, (uint16_t)0x44A4, (uint16_t)0x5485,
-    (uint16_t)0xA56A, (uint16_t)0xB54B, (uint16_t)0x8528, (uint16_t)0x9509, (uint16_t)0xE5EE, (uint16_t)0xF5CF, (uint16_t)0xC5AC, (uint16_t)0xD58D,
-    (uint16_t)0x3653, (uint16_t)0x2672, (uint16_t)0x1611, (uint16_t)0x0630, (uint16_t)0x76D7, (uint16_t)0x66F6, (uint16_t)0x5695, (uint16_t)0x46B4,
-    (uint16_t)0xB75B, (uint16_t)0xA77A, (uint16_t)0x9719, (uint16_t)0x8738, (uint16_t)0xF7DF, (uint16_t)0xE7FE, (uint16_t)0xD79D, (uint16_t)0xC7BC,
-    (uint16_t)0x48C4, (uint16_t)0x58E5, (uint16_t)0x6886, (uint16_t)0x78A7, (uint16_t)0x0840, (uint16_t)0x1861, (uint16_t)0x2802, (uint16_t)0x3823,
-    (uint16_t)0xC9CC, (uint16_t)0xD9ED, (uint16_t)0xE98E, (uint16_t)0xF9AF, (uint16_t)0x8948, (uint16_t)0x9969, (uint16_t)0xA90A, (uint16_t)0xB92B,
-    (uint16_t)0x5AF5, (uint16_t)0x4AD4, (uint16_t)0x7AB7, (uint16_t)0x6A96, (uint16_t)0x1A71, (uint16_t)0x0A50, (uint16_t)0x3A33, (uint16_t)0x2A12,
-    (uint16_t)0xDBFD, (uint16_t)0xCBDC, (uint16_t)0xFBBF, (uint16_t)0xEB9E, (uint16_t)0x9B79, (uint16_t)0x8B58, (uint16_t)0xBB3B, (uint16_t)0xAB1A,
-    (uint16_t)0x6CA6, (uint16_t)0x7C87, (uint16_t)0x4CE4, (uint16_t)0x5CC5, (uint16_t)0x2C22, (uint16_t)0x3C03, (uint16_t)0x0C60, (uint16_t)0x1C41,
-    (uint16_t)0xEDAE, (uint16_t)0xFD8F, (uint16_t)0xCDEC, (uint16_t)0xDDCD, (uint16_t)0xAD2A, (uint16_t)0xBD0B, (uint16_t)0x8D68, (uint16_t)0x9D49,
-    (uint16_t)0x7E97, (uint16_t)0x6EB6, (uint16_t)0x5ED5, (uint16_t)0x4EF4, (uint16_t)0x3E13, (uint16_t)0x2E32, (uint16_t)0x1E51, (uint16_t)0x0E70,
-    (uint16_t)0xFF9F, (uint16_t)0xEFBE, (uint16_t)0xDFDD, (uint16_t)0xCFFC, (uint16_t)0xBF1B, (uint16_t)0xAF3A, (uint16_t)0x9F59, (uint16_t)0x8F78,
-    (uint16_t)0x9188, (uint16_t)0x81A9, (uint16_t)0xB1CA, (uint16_t)0xA1EB, (uint16_t)0xD10C, (uint16_t)0xC12D, (uint16_t)0xF14E, (uint16_t)0xE16F,
-    (uint16_t)0x1080, (uint16_t)0x00A1, (uint16_t)0x30C2, (uint16_t)0x20E3, (uint16_t)0x5004, (uint16_t)0x4025, (uint16_t)0x7046, (uint16_t)0x6067,
-    (uint16_t)0x83B9, (uint16_t)0x9398, (uint16_t)0xA3FB, (uint16_t)0xB3DA, (uint16_t)0xC33D, (uint16_t)0xD31C, (uint16_t)0xE37F, (uint16_t)0xF35E,
-    (uint16_t)0x02B1, (uint16_t)0x1290, (uint16_t)0x22F3, (uint16_t)0x32D2, (uint16_t)0x4235, (uint16_t)0x5214, (uint16_t)0x6277, (uint16_t)0x7256,
-    (uint16_t)0xB5EA, (uint16_t)0xA5CB, (uint16_t)0x95A8, (uint16_t)0x8589, (uint16_t)0xF56E, (uint16_t)0xE54F, (uint16_t)0xD52C, (uint16_t)0xC50D,
-    (uint16_t)0x34E2, (uint16_t)0x24C3, (uint16_t)0x14A0, (uint16_t)0x0481, (uint16_t)0x7466, (uint16_t)0x6447, (uint16_t)0x5424, (uint16_t)0x4405,
-    (uint16_t)0xA7DB, (uint16_t)0xB7FA, (uint16_t)0x8799, (uint16_t)0x97B8, (uint16_t)0xE75F, (uint16_t)0xF77E, (uint16_t)0xC71D, (uint16_t)0xD73C,
-    (uint16_t)0x26D3, (uint16_t)0x36F2, (uint16_t)0x0691, (uint16_t)0x16B0, (uint16_t)0x6657, (uint16_t)0x7676, (uint16_t)0x4615, (uint16_t)0x5634,
-    (uint16_t)0xD94C, (uint16_t)0xC96D, (uint16_t)0xF90E, (uint16_t)0xE92F, (uint16_t)0x99C8, (uint16_t)0x89E9, (uint16_t)0xB98A, (uint16_t)0xA9AB,
-    (uint16_t)0x5844, (uint16_t)0x4865, (uint16_t)0x7806, (uint16_t)0x6827, (uint16_t)0x18C0, (uint16_t)0x08E1, (uint16_t)0x3882, (uint16_t)0x28A3,
-    (uint16_t)0xCB7D, (uint16_t)0xDB5C, (uint16_t)0xEB3F, (uint16_t)0xFB1E, (uint16_t)0x8BF9, (uint16_t)0x9BD8, (uint16_t)0xABBB, (uint16_t)0xBB9A,
-    (uint16_t)0x4A75, (uint16_t)0x5A54, (uint16_t)0x6A37, (uint16_t)0x7A16, (uint16_t)0x0AF1, (uint16_t)0x1AD0, (uint16_t)0x2AB3, (uint16_t)0x3A92,
-    (uint16_t)0xFD2E, (uint16_t)0xED0F, (uint16_t)0xDD6C, (uint16_t)0xCD4D, (uint16_t)0xBDAA, (uint16_t)0xAD8B, (uint16_t)0x9DE8, (uint16_t)0x8DC9,
-    (uint16_t)0x7C26, (uint16_t)0x6C07, (uint16_t)0x5C64, (uint16_t)0x4C45, (uint16_t)0x3CA2, (uint16_t)0x2C83, (uint16_t)0x1CE0, (uint16_t)0x0CC1,
-    (uint16_t)0xEF1F, (uint16_t)0xFF3E, (uint16_t)0xCF5D, (uint16_t)0xDF7C, (uint16_t)0xAF9B, (uint16_t)0xBFBA, (uint16_t)0x8FD9, (uint16_t)0x9FF8,
-    (uint16_t)0x6E17, (uint16_t)0x7E36, (uint16_t)0x4E55, (uint16_t)0x5E74, (uint16_t)0x2E93, (uint16_t)0x3EB2, (uint16_t)0x0ED1, (uint16_t)0x1EF0,
-};
 
-#elif XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_32
-
-#define XCP_CRC_NAME            "CRC-32"
-#define XCP_CRC_POLYNOMIAL      ((uint32_t)0x04C11DB7)
-#define XCP_CRC_INITIAL_VALUE   ((uint32_t)0xFFFFFFFF)
-#define XCP_CRC_FINAL_XOR_VALUE ((uint32_t)0xFFFFFFFF)
-#define REFLECT_DATA            XCP_TRUE
-#define REFLECT_REMAINDER       XCP_TRUE
-#define CHECK_VALUE             ((uint32_t)0xCBF43926)
-
-static const uint32_t CRC_TAB[] = {
-    (uint32_t)0x00000000, (uint32_t)0x77073096, (uint32_t)0xee0e612c, (uint32_t)0x990951ba, (uint32_t)0x076dc419,
-    (uint32_t)0x706af48f, (uint32_t)0xe963a535, (uint32_t)0x9e6495a3, (uint32_t)0x0edb8832, (uint32_t)0x79dcb8a4,
-    (uint32_t)0xe0d5e91e, (uint32_t)0x97d2d988, (uint32_t)0x09b64c2b, (uint32_t)0x7eb17cbd, (uint32_t)0xe7b82d07,
-    (uint32_t)0x90bf1d91, (uint32_t)0x1db71064, (uint32_t)0x6ab020f2, (uint32_t)0xf3b97148, (uint32_t)0x84be41de,
-    (uint32_t)0x1adad47d, (uint32_t)0x6ddde4eb, (uint32_t)0xf4d4b551, (uint32_t)0x83d385c7, (uint32_t)0x136c9856,
-    (uint32_t)0x646ba8c0, (uint32_t)0xfd62f97a, (uint32_t)0x8a65c9ec, (uint32_t)0x14015c4f, (uint32_t)0x63066cd9,
-    (uint32_t)0xfa0f3d63, (uint32_t)0x8d080df5, (uint32_t)0x3b6e20c8, (uint32_t)0x4c69105e, (uint32_t)0xd56041e4,
-    (uint32_t)0xa2677172, (uint32_t)0x3c03e4d1, (uint32_t)0x4b04d447, (uint32_t)0xd20d85fd, (uint32_t)0xa50ab56b,
-    (uint32_t)0x35b5a8fa, (uint32_t)0x42b2986c, (uint32_t)0xdbbbc9d6, (uint32_t)0xacbcf940, (uint32_t)0x32d86ce3,
-    (uint32_t)0x45df5c75, (uint32_t)0xdcd60dcf, (uint32_t)0xabd13d59, (uint32_t)0x26d930ac, (uint32_t)0x51de003a,
-    (uint32_t)0xc8d75180, (uint32_t)0xbfd06116, (uint32_t)0x21b4f4b5, (uint32_t)0x56b3c423, (uint32_t)0xcfba9599,
-    (uint32_t)0xb8bda50f, (uint32_t)0x2802b89e, (uint32_t)0x5f058808, (uint32_t)0xc60cd9b2, (uint32_t)0xb10be924,
-    (uint32_t)0x2f6f7c87, (uint32_t)0x58684c11, (uint32_t)0xc1611dab, (uint32_t)0xb6662d3d, (uint32_t)0x76dc4190,
-    (uint32_t)0x01db7106, (uint32_t)0x98d220bc, (uint32_t)0xefd5102a, (uint32_t)0x71b18589, (uint32_t)0x06b6b51f,
-    (uint32_t)0x9fbfe4a5, (uint32_t)0xe8b8d433, (uint32_t)0x7807c9a2, (uint32_t)0x0f00f934, (uint32_t)0x9609a88e,
-    (uint32_t)0xe10e9818, (uint32_t)0x7f6a0dbb, (uint32_t)0x086d3d2d, (uint32_t)0x91646c97, (uint32_t)0xe6635c01,
-    (uint32_t)0x6b6b51f4, (uint32_t)0x1c6c6162, (uint32_t)0x856530d8, (uint32_t)0xf262004e, (uint32_t)0x6c0695ed,
-    (uint32_t)0x1b01a57b, (uint32_t)0x8208f4c1, (uint32_t)0xf50fc457, (uint32_t)0x65b0d9c6, (uint32_t)0x12b7e950,
-    (uint32_t)0x8bbeb8ea, (uint32_t)0xfcb9887c, (uint32_t)0x62dd1ddf, (uint32_t)0x15da2d49, (uint32_t)0x8cd37cf3,
-    (uint32_t)0xfbd44c65, (uint32_t)0x4db26158, (uint32_t)0x3ab551ce, (uint32_t)0xa3bc0074, (uint32_t)0xd4bb30e2,
-    (uint32_t)0x4adfa541, (uint32_t)0x3dd895d7, (uint32_t)0xa4d1c46d, (uint32_t)0xd3d6f4fb, (uint32_t)0x4369e96a,
-    (uint32_t)0x346ed9fc, (uint32_t)0xad678846, (uint32_t)0xda60b8d0, (uint32_t)0x44042d73, (uint32_t)0x33031de5,
-    (uint32_t)0xaa0a4c5f, (uint32_t)0xdd0d7cc9, (uint32_t)0x5005713c, (uint32_t)0x270241aa, (uint32_t)0xbe0b1010,
-    (uint32_t)0xc90c2086, (uint32_t)0x5768b525, (uint32_t)0x206f85b3, (uint32_t)0xb966d409, (uint32_t)0xce61e49f,
-    (uint32_t)0x5edef90e, (uint32_t)0x29d9c998, (uint32_t)0xb0d09822, (uint32_t)0xc7d7a8b4, (uint32_t)0x59b33d17,
-    (uint32_t)0x2eb40d81, (uint32_t)0xb7bd5c3b, (uint32_t)0xc0ba6cad, (uint32_t)0xedb88320, (uint32_t)0x9abfb3b6,
-    (uint32_t)0x03b6e20c, (uint32_t)0x74b1d29a, (uint32_t)0xead54739, (uint32_t)0x9dd277af, (uint32_t)0x04db2615,
-    (uint32_t)0x73dc1683, (uint32_t)0xe3630b12, (uint32_t)0x94643b84, (uint32_t)0x0d6d6a3e, (uint32_t)0x7a6a5aa8,
-    (uint32_t)0xe40ecf0b, (uint32_t)0x9309ff9d, (uint32_t)0x0a00ae27, (uint32_t)0x7d079eb1, (uint32_t)0xf00f9344,
-    (uint32_t)0x8708a3d2, (uint32_t)0x1e01f268, (uint32_t)0x6906c2fe, (uint32_t)0xf762575d, (uint32_t)0x806567cb,
-    (uint32_t)0x196c3671, (uint32_t)0x6e6b06e7, (uint32_t)0xfed41b76, (uint32_t)0x89d32be0, (uint32_t)0x10da7a5a,
-    (uint32_t)0x67dd4acc, (uint32_t)0xf9b9df6f, (uint32_t)0x8ebeeff9, (uint32_t)0x17b7be43, (uint32_t)0x60b08ed5,
-    (uint32_t)0xd6d6a3e8, (uint32_t)0xa1d1937e, (uint32_t)0x38d8c2c4, (uint32_t)0x4fdff252, (uint32_t)0xd1bb67f1,
-    (uint32_t)0xa6bc5767, (uint32_t)0x3fb506dd, (uint32_t)0x48b2364b, (uint32_t)0xd80d2bda, (uint32_t)0xaf0a1b4c,
-    (uint32_t)0x36034af6, (uint32_t)0x41047a60, (uint32_t)0xdf60efc3, (uint32_t)0xa867df55, (uint32_t)0x316e8eef,
-    (uint32_t)0x4669be79, (uint32_t)0xcb61b38c, (uint32_t)0xbc66831a, (uint32_t)0x256fd2a0, (uint32_t)0x5268e236,
-    (uint32_t)0xcc0c7795, (uint32_t)0xbb0b4703, (uint32_t)0x220216b9, (uint32_t)0x5505262f, (uint32_t)0xc5ba3bbe,
-    (uint32_t)0xb2bd0b28, (uint32_t)0x2bb45a92, (uint32_t)0x5cb36a04, (uint32_t)0xc2d7ffa7, (uint32_t)0xb5d0cf31,
-    (uint32_t)0x2cd99e8b, (uint32_t)0x5bdeae1d, (uint32_t)0x9b64c2b0, (uint32_t)0xec63f226, (uint32_t)0x756aa39c,
-    (uint32_t)0x026d930a, (uint32_t)0x9c0906a9, (uint32_t)0xeb0e363f, (uint32_t)0x72076785, (uint32_t)0x05005713,
-    (uint32_t)0x95bf4a82, (uint32_t)0xe2b87a14, (uint32_t)0x7bb12bae, (uint32_t)0x0cb61b38, (uint32_t)0x92d28e9b,
-    (uint32_t)0xe5d5be0d, (uint32_t)0x7cdcefb7, (uint32_t)0x0bdbdf21, (uint32_t)0x86d3d2d4, (uint32_t)0xf1d4e242,
-    (uint32_t)0x68ddb3f8, (uint32_t)0x1fda836e, (uint32_t)0x81be16cd, (uint32_t)0xf6b9265b, (uint32_t)0x6fb077e1,
-    (uint32_t)0x18b74777, (uint32_t)0x88085ae6, (uint32_t)0xff0f6a70, (uint32_t)0x66063bca, (uint32_t)0x11010b5c,
-    (uint32_t)0x8f659eff, (uint32_t)0xf862ae69, (uint32_t)0x616bffd3, (uint32_t)0x166ccf45, (uint32_t)0xa00ae278,
-    (uint32_t)0xd70dd2ee, (uint32_t)0x4e048354, (uint32_t)0x3903b3c2, (uint32_t)0xa7672661, (uint32_t)0xd06016f7,
-    (uint32_t)0x4969474d, (uint32_t)0x3e6e77db, (uint32_t)0xaed16a4a, (uint32_t)0xd9d65adc, (uint32_t)0x40df0b66,
-    (uint32_t)0x37d83bf0, (uint32_t)0xa9bcae53, (uint32_t)0xdebb9ec5, (uint32_t)0x47b2cf7f, (uint32_t)0x30b5ffe9,
-    (uint32_t)0xbdbdf21c, (uint32_t)0xcabac28a, (uint32_t)0x53b39330, (uint32_t)0x24b4a3a6, (uint32_t)0xbad03605,
-    (uint32_t)0xcdd70693, (uint32_t)0x54de5729, (uint32_t)0x23d967bf, (uint32_t)0xb3667a2e, (uint32_t)0xc4614ab8,
-    (uint32_t)0x5d681b02, (uint32_t)0x2a6f2b94, (uint32_t)0xb40bbe37, (uint32_t)0xc30c8ea1, (uint32_t)0x5a05df1b,
-    (uint32_t)0x2d02ef8d
+/*
+**  Local Variables
+*/
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_CRC_16)
+static Xcp_CrcStateType Xcp_Crc16State;
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT)
+static Xcp_CrcStateType Xcp_CrcCcittState;
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_CRC_32)
+static Xcp_CrcStateType Xcp_Crc32State;
+#endif
+
+static const Xcp_ChecksumMethodType Xcp_ChecksumMethods[] = {
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_ADD_11)
+    { XCP_CHECKSUM_METHOD_XCP_ADD_11, UINT8(1), UINT8(1), UINT8(8), (bool)XCP_FALSE, UINT32(0), UINT32(0), UINT32(0), XCP_NULL },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_ADD_12)
+    { XCP_CHECKSUM_METHOD_XCP_ADD_12, UINT8(1), UINT8(1), UINT8(16), (bool)XCP_FALSE, UINT32(0), UINT32(0), UINT32(0), XCP_NULL },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_ADD_14)
+    { XCP_CHECKSUM_METHOD_XCP_ADD_14, UINT8(1), UINT8(1), UINT8(32), (bool)XCP_FALSE, UINT32(0), UINT32(0), UINT32(0), XCP_NULL },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_ADD_22)
+    { XCP_CHECKSUM_METHOD_XCP_ADD_22, UINT8(2), UINT8(2), UINT8(16), (bool)XCP_FALSE, UINT32(0), UINT32(0), UINT32(0), XCP_NULL },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_ADD_24)
+    { XCP_CHECKSUM_METHOD_XCP_ADD_24, UINT8(2), UINT8(2), UINT8(32), (bool)XCP_FALSE, UINT32(0), UINT32(0), UINT32(0), XCP_NULL },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_ADD_44)
+    { XCP_CHECKSUM_METHOD_XCP_ADD_44, UINT8(4), UINT8(4), UINT8(32), (bool)XCP_FALSE, UINT32(0), UINT32(0), UINT32(0), XCP_NULL },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_CRC_16)
+    /* CRC-16/ARC, check value 0xBB3D. */
+    { XCP_CHECKSUM_METHOD_XCP_CRC_16, UINT8(1), UINT8(1), UINT8(16), (bool)XCP_TRUE,
+      UINT32(0x8005), UINT32(0x0000), UINT32(0x0000), &Xcp_Crc16State },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT)
+    /* CRC-16/CCITT-FALSE, check value 0x29B1. */
+    { XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT, UINT8(1), UINT8(1), UINT8(16), (bool)XCP_FALSE,
+      UINT32(0x1021), UINT32(0xFFFF), UINT32(0x0000), &Xcp_CrcCcittState },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_CRC_32)
+    /* CRC-32 (IEEE 802.3), check value 0xCBF43926. */
+    { XCP_CHECKSUM_METHOD_XCP_CRC_32, UINT8(1), UINT8(1), UINT8(32), (bool)XCP_TRUE,
+      UINT32(0x04C11DB7), UINT32(0xFFFFFFFF), UINT32(0xFFFFFFFF), &Xcp_Crc32State },
+#endif
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_USER_DEFINED)
+    { XCP_CHECKSUM_METHOD_XCP_USER_DEFINED, UINT8(1), UINT8(64), UINT8(61), (bool)XCP_FALSE,
+      UINT32(0), UINT32(0), UINT32(0), XCP_NULL },
+#endif
 };
 
+#define XCP_CHECKSUM_NUM_METHODS    UINT8(sizeof(Xcp_ChecksumMethods) / sizeof(Xcp_ChecksumMethods[0]))
 
-#endif // XCP_CHECKSUM_METHOD
+static Xcp_ChecksumMethodType const * Xcp_ChecksumActiveMethod = &Xcp_ChecksumMethods[0];
 
-#define WIDTH    ((uint16_t)(8U * sizeof(Xcp_ChecksumType)))
-#define TOPBIT   (1 << (WIDTH - 1))
 
-#if (REFLECT_DATA == XCP_TRUE)
-#define CRC_REFLECT_DATA(X)         ((uint8_t) reflect((X), 8))
-#else
-#define CRC_REFLECT_DATA(X)         (X)
+static Xcp_ChecksumType Xcp_ChecksumMask(Xcp_ChecksumMethodType const * method)
+{
+    return (method->width >= UINT8(sizeof(Xcp_ChecksumType) * 8)) ?
+        ~(Xcp_ChecksumType)0 : (((Xcp_ChecksumType)1 << method->width) - (Xcp_ChecksumType)1);
+}
+
+
+#if defined(XCP_CHECKSUM_HAS_CRC)
+/*
+**  Register <--> CRC value.
+*/
+static uint32_t Xcp_CrcToRegister(Xcp_ChecksumMethodType const * method, uint32_t value)
+{
+    return (method->reflected == (bool)XCP_TRUE) ? value : (value << (UINT8(32) - method->width));
+}
+
+static uint32_t Xcp_CrcFromRegister(Xcp_ChecksumMethodType const * method, uint32_t reg)
+{
+    return (method->reflected == (bool)XCP_TRUE) ? reg : (reg >> (UINT8(32) - method->width));
+}
+
+/*
+**  x^0 resp. x^1 in register bit order (reflected: x^0 is the top bit).
+*/
+static uint32_t Xcp_CrcX0(Xcp_ChecksumMethodType const * method)
+{
+    return (method->reflected == (bool)XCP_TRUE) ? (UINT32(1) << (method->width - UINT8(1))) : (UINT32(1) << (UINT8(32) - method->width));
+}
+
+static uint32_t Xcp_CrcX1(Xcp_ChecksumMethodType const * method)
+{
+    return (method->reflected == (bool)XCP_TRUE) ? (Xcp_CrcX0(method) >> 1) : (Xcp_CrcX0(method) << 1);
+}
+
+/*
+**  GF(2) polynomial multiplication modulo P(x), operands in register bit order.
+*/
+static uint32_t Xcp_CrcMultModP(Xcp_ChecksumMethodType const * method, uint32_t a, uint32_t b)
+{
+    uint32_t const poly = method->crc->polynomial;
+    uint32_t product = UINT32(0);
+    uint32_t mask;
+
+    if (method->reflected == (bool)XCP_TRUE) {
+        mask = Xcp_CrcX0(method);
+        for (;;) {
+            if ((a & mask) != UINT32(0)) {
+                product ^= b;
+                if ((a & (mask - UINT32(1))) == UINT32(0)) {
+                    break;
+                }
+            }
+            mask >>= 1;
+            b = ((b & UINT32(1)) != UINT32(0)) ? ((b >> 1) ^ poly) : (b >> 1);
+        }
+    } else {
+        for (mask = UINT32(0x80000000); mask >= Xcp_CrcX0(method); mask >>= 1) {
+            product = ((product & UINT32(0x80000000)) != UINT32(0)) ? ((product << 1) ^ poly) : (product << 1);
+            if ((a & mask) != UINT32(0)) {
+                product ^= b;
+            }
+        }
+    }
+    return product;
+}
+
+/*
+**  x^(length * 8) modulo P(x).
+*/
+static uint32_t Xcp_CrcShiftBytes(Xcp_ChecksumMethodType const * method, uint32_t length)
+{
+    uint32_t result = Xcp_CrcX0(method);
+    uint8_t k = UINT8(3);
+
+    while (length > UINT32(0)) {
+        if ((length & UINT32(1)) != UINT32(0)) {
+            result = Xcp_CrcMultModP(method, method->crc->x2n[k & UINT8(31)], result);
+        }
+        length >>= 1;
+        ++k;
+    }
+    return result;
+}
+
+static void Xcp_CrcGenerateTables(Xcp_ChecksumMethodType const * method)
+{
+    Xcp_CrcStateType * const state = method->crc;
+    uint32_t poly = UINT32(0);
+    uint16_t idx;
+    uint8_t bit;
+    uint8_t slice;
+    uint32_t crc;
+
+    if (method->reflected == (bool)XCP_TRUE) {
+        for (bit = UINT8(0); bit < method->width; ++bit) {
+            if ((method->polynomial & (UINT32(1) << bit)) != UINT32(0)) {
+                poly |= UINT32(1) << (method->width - UINT8(1) - bit);
+            }
+        }
+    } else {
+        poly = method->polynomial << (UINT8(32) - method->width);
+    }
+    state->polynomial = poly;
+
+    for (idx = UINT16(0); idx < UINT16(256); ++idx) {
+        if (method->reflected == (bool)XCP_TRUE) {
+            crc = UINT32(idx);
+            for (bit = UINT8(0); bit < UINT8(8); ++bit) {
+                crc = ((crc & UINT32(1)) != UINT32(0)) ? ((crc >> 1) ^ poly) : (crc >> 1);
+            }
+        } else {
+            crc = UINT32(idx) << 24;
+            for (bit = UINT8(0); bit < UINT8(8); ++bit) {
+                crc = ((crc & UINT32(0x80000000)) != UINT32(0)) ? ((crc << 1) ^ poly) : (crc << 1);
+            }
+        }
+        state->table[0][idx] = crc;
+    }
+    for (slice = UINT8(1); slice < UINT8(XCP_CRC_SLICES); ++slice) {
+        for (idx = UINT16(0); idx < UINT16(256); ++idx) {
+            crc = state->table[slice - 1][idx];
+            if (method->reflected == (bool)XCP_TRUE) {
+                crc = (crc >> 8) ^ state->table[0][crc & UINT32(0xff)];
+            } else {
+                crc = (crc << 8) ^ state->table[0][crc >> 24];
+            }
+            state->table[slice][idx] = crc;
+        }
+    }
+    state->x2n[0] = Xcp_CrcX1(method);
+    for (idx = UINT16(1); idx < UINT16(32); ++idx) {
+        state->x2n[idx] = Xcp_CrcMultModP(method, state->x2n[idx - 1], state->x2n[idx - 1]);
+    }
+}
+
+static uint32_t Xcp_CrcUpdateReflected(Xcp_CrcStateType const * state, uint32_t crc, uint8_t const * ptr, uint32_t length)
+{
+    uint32_t const (* const table)[256] = state->table;
+    uint32_t one;
+    uint32_t two;
+
+    while (length >= UINT32(8)) {
+        one = (UINT32(ptr[0]) | (UINT32(ptr[1]) << 8) | (UINT32(ptr[2]) << 16) | (UINT32(ptr[3]) << 24)) ^ crc;
+        two = (UINT32(ptr[4]) | (UINT32(ptr[5]) << 8) | (UINT32(ptr[6]) << 16) | (UINT32(ptr[7]) << 24));
+        crc = table[7][one & UINT32(0xff)] ^ table[6][(one >> 8) & UINT32(0xff)] ^
+              table[5][(one >> 16) & UINT32(0xff)] ^ table[4][one >> 24] ^
+              table[3][two & UINT32(0xff)] ^ table[2][(two >> 8) & UINT32(0xff)] ^
+              table[1][(two >> 16) & UINT32(0xff)] ^ table[0][two >> 24];
+        ptr += 8;
+        length -= UINT32(8);
+    }
+    while (length > UINT32(0)) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *ptr) & UINT32(0xff)];
+        ++ptr;
+        --length;
+    }
+    return crc;
+}
+
+static uint32_t Xcp_CrcUpdateNormal(Xcp_CrcStateType const * state, uint32_t crc, uint8_t const * ptr, uint32_t length)
+{
+    uint32_t const (* const table)[256] = state->table;
+    uint32_t one;
+
+    while (length >= UINT32(8)) {
+        one = ((UINT32(ptr[0]) << 24) | (UINT32(ptr[1]) << 16) | (UINT32(ptr[2]) << 8) | UINT32(ptr[3])) ^ crc;
+        crc = table[7][one >> 24] ^ table[6][(one >> 16) & UINT32(0xff)] ^
+              table[5][(one >> 8) & UINT32(0xff)] ^ table[4][one & UINT32(0xff)] ^
+              table[3][ptr[4]] ^ table[2][ptr[5]] ^
+              table[1][ptr[6]] ^ table[0][ptr[7]];
+        ptr += 8;
+        length -= UINT32(8);
+    }
+    while (length > UINT32(0)) {
+        crc = (crc << 8) ^ table[0][(crc >> 24) ^ UINT32(*ptr)];
+        ++ptr;
+        --length;
+    }
+    return crc;
+}
+#endif // XCP_CHECKSUM_HAS_CRC
+
+
+#if XCP_CHECKSUM_METHOD_AVAILABLE(XCP_CHECKSUM_METHOD_XCP_CRC_32)
+/*
+**  Carry-less multiply folding for CRC-32 (Intel white paper "Fast CRC
+**  Computation for Generic Polynomials Using PCLMULQDQ Instruction"):
+**  four 128 bit lanes fold 64 bytes per iteration, followed by a reduction to
+**  128 bits, a 16 byte fold loop and a Barrett reduction to 32 bits.
+**  The kernel is selected at run-time (CPUID resp. AT_HWCAP), remaining bytes
+**  and CPUs without PCLMULQDQ / PMULL are handled by the table engine.
+**  The intrinsics headers need the <stdint.h> types (s. xcp_types.h).
+*/
+#if !defined(XCP_HAS_STDINT_H)
+    /* Table engine only. */
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    #define XCP_CRC_CLMUL_X86
+    #include <cpuid.h>
+    #include <emmintrin.h>
+    #include <wmmintrin.h>
+    #define XCP_CRC_CLMUL_TARGET    __attribute__((target("sse2,pclmul")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+    #define XCP_CRC_CLMUL_X86
+    #include <intrin.h>
+    #define XCP_CRC_CLMUL_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__) && (defined(__linux__) || defined(__APPLE__))
+    #define XCP_CRC_CLMUL_ARM
+    #include <arm_neon.h>
+    #if defined(__linux__)
+        #include <sys/auxv.h>
+        #if !defined(HWCAP_PMULL)
+            #define HWCAP_PMULL (1 << 4)
+        #endif
+    #endif
+    #if defined(__clang__)
+        #define XCP_CRC_CLMUL_TARGET    __attribute__((target("aes")))
+    #else
+        #define XCP_CRC_CLMUL_TARGET    __attribute__((target("+crypto")))
+    #endif
 #endif
 
-#if (REFLECT_REMAINDER == XCP_TRUE)
-#define CRC_REFLECT_REMAINDER(X)    ((Xcp_ChecksumType) reflect((X), WIDTH))
+#if defined(XCP_CRC_CLMUL_X86) || defined(XCP_CRC_CLMUL_ARM)
+#define XCP_CRC_CLMUL
+
+#define XCP_CRC_CLMUL_MIN_LENGTH    UINT32(64)
+
+/* Bit-reflected folding constants x^n mod P(x) and the Barrett constants. */
+static const uint64_t Xcp_CrcClmulK1K2[2] = { UINT64(0x0154442bd4), UINT64(0x01c6e41596) };
+static const uint64_t Xcp_CrcClmulK3K4[2] = { UINT64(0x01751997d0), UINT64(0x00ccaa009e) };
+static const uint64_t Xcp_CrcClmulK5K0[2] = { UINT64(0x0163cd6124), UINT64(0x0000000000) };
+static const uint64_t Xcp_CrcClmulPoly[2] = { UINT64(0x01db710641), UINT64(0x01f7011641) };
+
+static bool Xcp_CrcHasClmul = (bool)XCP_FALSE;
+
+static void Xcp_CrcDetectClmul(void)
+{
+#if defined(XCP_CRC_CLMUL_X86)
+#if defined(_MSC_VER)
+    int regs[4];
+
+    __cpuid(regs, 1);
+    Xcp_CrcHasClmul = ((UINT32(regs[2]) & UINT32(0x02)) != UINT32(0)) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+#else
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        Xcp_CrcHasClmul = ((ecx & bit_PCLMUL) != 0u) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+    }
+#endif // _MSC_VER
+#elif defined(__APPLE__)
+    Xcp_CrcHasClmul = (bool)XCP_TRUE;   /* All Apple arm64 cores implement PMULL. */
 #else
-#define CRC_REFLECT_REMAINDER(X)    (X)
+    Xcp_CrcHasClmul = ((getauxval(AT_HWCAP) & HWCAP_PMULL) != 0ul) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+#endif // XCP_CRC_CLMUL_X86
+}
+
+#if defined(XCP_CRC_CLMUL_X86)
+/*
+**  'length' must be a multiple of 16 and at least 64.
+*/
+XCP_CRC_CLMUL_TARGET static uint32_t Xcp_CrcFoldClmul(uint32_t crc, uint8_t const * ptr, uint32_t length)
+{
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    __m128i const mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+
+    x1 = _mm_loadu_si128((__m128i const *)(ptr + 0x00));
+    x2 = _mm_loadu_si128((__m128i const *)(ptr + 0x10));
+    x3 = _mm_loadu_si128((__m128i const *)(ptr + 0x20));
+    x4 = _mm_loadu_si128((__m128i const *)(ptr + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    x0 = _mm_loadu_si128((__m128i const *)Xcp_CrcClmulK1K2);
+    ptr += 64;
+    length -= UINT32(64);
+
+    /* Fold 4x128 bits. */
+    while (length >= UINT32(64)) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((__m128i const *)(ptr + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((__m128i const *)(ptr + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((__m128i const *)(ptr + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((__m128i const *)(ptr + 0x30)));
+        ptr += 64;
+        length -= UINT32(64);
+    }
+
+    /* Reduce to 128 bits. */
+    x0 = _mm_loadu_si128((__m128i const *)Xcp_CrcClmulK3K4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Fold remaining 16 byte blocks. */
+    while (length >= UINT32(16)) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((__m128i const *)ptr));
+        ptr += 16;
+        length -= UINT32(16);
+    }
+
+    /* 128 --> 64 bits. */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x0 = _mm_loadu_si128((__m128i const *)Xcp_CrcClmulK5K0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduction --> 32 bits. */
+    x0 = _mm_loadu_si128((__m128i const *)Xcp_CrcClmulPoly);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return UINT32(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+}
+#else
+XCP_CRC_CLMUL_TARGET static inline uint64x2_t Xcp_CrcPmullLo(uint64x2_t a, uint64x2_t b)
+{
+    return vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(a, 0), (poly64_t)vgetq_lane_u64(b, 0)));
+}
+
+XCP_CRC_CLMUL_TARGET static inline uint64x2_t Xcp_CrcPmullHi(uint64x2_t a, uint64x2_t b)
+{
+    return vreinterpretq_u64_p128(vmull_high_p64(vreinterpretq_p64_u64(a), vreinterpretq_p64_u64(b)));
+}
+
+/*
+**  Low half of 'a' times high half of 'b'.
+*/
+XCP_CRC_CLMUL_TARGET static inline uint64x2_t Xcp_CrcPmullLoHi(uint64x2_t a, uint64x2_t b)
+{
+    return vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(a, 0), (poly64_t)vgetq_lane_u64(b, 1)));
+}
+
+XCP_CRC_CLMUL_TARGET static inline uint64x2_t Xcp_CrcLoad(uint8_t const * ptr)
+{
+    return vreinterpretq_u64_u8(vld1q_u8(ptr));
+}
+
+/*
+**  Byte-wise right shift of the whole 128 bit register (like PSRLDQ).
+*/
+#define XCP_CRC_SHIFT_RIGHT(a, bytes)   vreinterpretq_u64_u8(vextq_u8(vreinterpretq_u8_u64(a), vdupq_n_u8(0), (bytes)))
+
+/*
+**  'length' must be a multiple of 16 and at least 64.
+*/
+XCP_CRC_CLMUL_TARGET static uint32_t Xcp_CrcFoldClmul(uint32_t crc, uint8_t const * ptr, uint32_t length)
+{
+    uint64x2_t x0, x1, x2, x3, x4, x5, x6, x7, x8;
+    uint64x2_t const mask32 = vdupq_n_u64(UINT64(0xffffffff));
+
+    x1 = Xcp_CrcLoad(ptr + 0x00);
+    x2 = Xcp_CrcLoad(ptr + 0x10);
+    x3 = Xcp_CrcLoad(ptr + 0x20);
+    x4 = Xcp_CrcLoad(ptr + 0x30);
+    x1 = veorq_u64(x1, vsetq_lane_u64((uint64_t)crc, vdupq_n_u64(UINT64(0)), 0));
+    x0 = vld1q_u64(Xcp_CrcClmulK1K2);
+    ptr += 64;
+    length -= UINT32(64);
+
+    /* Fold 4x128 bits. */
+    while (length >= UINT32(64)) {
+        x5 = Xcp_CrcPmullLo(x1, x0);
+        x6 = Xcp_CrcPmullLo(x2, x0);
+        x7 = Xcp_CrcPmullLo(x3, x0);
+        x8 = Xcp_CrcPmullLo(x4, x0);
+        x1 = Xcp_CrcPmullHi(x1, x0);
+        x2 = Xcp_CrcPmullHi(x2, x0);
+        x3 = Xcp_CrcPmullHi(x3, x0);
+        x4 = Xcp_CrcPmullHi(x4, x0);
+        x1 = veorq_u64(veorq_u64(x1, x5), Xcp_CrcLoad(ptr + 0x00));
+        x2 = veorq_u64(veorq_u64(x2, x6), Xcp_CrcLoad(ptr + 0x10));
+        x3 = veorq_u64(veorq_u64(x3, x7), Xcp_CrcLoad(ptr + 0x20));
+        x4 = veorq_u64(veorq_u64(x4, x8), Xcp_CrcLoad(ptr + 0x30));
+        ptr += 64;
+        length -= UINT32(64);
+    }
+
+    /* Reduce to 128 bits. */
+    x0 = vld1q_u64(Xcp_CrcClmulK3K4);
+    x5 = Xcp_CrcPmullLo(x1, x0);
+    x1 = Xcp_CrcPmullHi(x1, x0);
+    x1 = veorq_u64(veorq_u64(x1, x2), x5);
+    x5 = Xcp_CrcPmullLo(x1, x0);
+    x1 = Xcp_CrcPmullHi(x1, x0);
+    x1 = veorq_u64(veorq_u64(x1, x3), x5);
+    x5 = Xcp_CrcPmullLo(x1, x0);
+    x1 = Xcp_CrcPmullHi(x1, x0);
+    x1 = veorq_u64(veorq_u64(x1, x4), x5);
+
+    /* Fold remaining 16 byte blocks. */
+    while (length >= UINT32(16)) {
+        x5 = Xcp_CrcPmullLo(x1, x0);
+        x1 = Xcp_CrcPmullHi(x1, x0);
+        x1 = veorq_u64(veorq_u64(x1, x5), Xcp_CrcLoad(ptr));
+        ptr += 16;
+        length -= UINT32(16);
+    }
+
+    /* 128 --> 64 bits. */
+    x2 = Xcp_CrcPmullLoHi(x1, x0);
+    x1 = veorq_u64(XCP_CRC_SHIFT_RIGHT(x1, 8), x2);
+    x0 = vld1q_u64(Xcp_CrcClmulK5K0);
+    x2 = XCP_CRC_SHIFT_RIGHT(x1, 4);
+    x1 = Xcp_CrcPmullLo(vandq_u64(x1, mask32), x0);
+    x1 = veorq_u64(x1, x2);
+
+    /* Barrett reduction --> 32 bits. */
+    x0 = vld1q_u64(Xcp_CrcClmulPoly);
+    x2 = Xcp_CrcPmullLoHi(vandq_u64(x1, mask32), x0);
+    x2 = Xcp_CrcPmullLo(vandq_u64(x2, mask32), x0);
+    x1 = veorq_u64(x1, x2);
+
+    return vgetq_lane_u32(vreinterpretq_u32_u64(x1), 1);
+}
+#endif // XCP_CRC_CLMUL_X86
+#endif // XCP_CRC_CLMUL_X86 || XCP_CRC_CLMUL_ARM
+#endif // XCP_CHECKSUM_METHOD_AVAILABLE
+
+
+#if defined(XCP_CHECKSUM_HAS_ADD)
+/*
+**  Additive checksums are computed from per-position byte sums: sums[k] holds
+**  all bytes whose offset from the start of the block is k modulo the element
+**  size, the element sum is then formed by weighting each position according
+**  to the byte order. This is exact for any alignment and length (a trailing
+**  partial element counts as if zero-padded) and needs no unaligned word
+**  accesses.
+**  On x86-64 the bulk is summed over aligned vectors (SSE2, resp. AVX2 if
+**  available): PSADBW for byte sums, 16 bit lane accumulators for word sums;
+**  the intrinsics headers need the <stdint.h> types (s. xcp_types.h).
+*/
+#if !defined(XCP_HAS_STDINT_H)
+    /* Bytewise sums only. */
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    #define XCP_CHECKSUM_ADD_SIMD
+    #include <immintrin.h>
+    #define XCP_CHECKSUM_AVX2_TARGET    __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+    #define XCP_CHECKSUM_ADD_SIMD
+    #include <intrin.h>
+    #define XCP_CHECKSUM_AVX2_TARGET
 #endif
 
- #if (REFLECT_DATA == XCP_TRUE) || (REFLECT_REMAINDER == XCP_TRUE)
-static uint32_t reflect(uint32_t data, uint8_t nBits)
-{
-        uint32_t  reflection = 0x00000000;
-        uint8_t  bit;
-        /*
-         * Reflect the data about the center bit.
-         */
-        for (bit = 0; bit < nBits; ++bit) {
-                /*
-                 * If the LSB bit is set, set the reflection of it.
-                 */
-                if (data & 0x01) {
-                        reflection |= (1 << ((nBits - 1) - bit));
-                }
-                data = (data >> 1);
+#define XCP_CHECKSUM_MAX_ELEMENT_SIZE   (4)
+
+static void Xcp_ChecksumAddBytes(uint8_t const * ptr, uint32_t length, uint32_t phase, uint8_t elementSize, uint64_t * sums)
+{
+    uint32_t idx;
+
+    for (idx = UINT32(0); idx < length; ++idx) {
+        sums[(phase + idx) % UINT32(elementSize)] += UINT64(ptr[idx]);
+    }
+}
+
+#if defined(XCP_CHECKSUM_ADD_SIMD)
+/*
+**  Word sums keep even and odd bytes in 16 bit lanes for at most this many
+**  vectors (128 * 255 still fits into a signed 16 bit lane for PMADDWD).
+*/
+#define XCP_CHECKSUM_SIMD_RUN   UINT32(128)
+
+static bool Xcp_ChecksumHasAvx2 = (bool)XCP_FALSE;
+
+static void Xcp_ChecksumDetectAvx2(void)
+{
+#if defined(_MSC_VER)
+    int regs[4];
+
+    __cpuid(regs, 1);
+    /* OSXSAVE and AVX, and the OS saves the YMM state. */
+    if (((UINT32(regs[2]) & UINT32(0x18000000)) == UINT32(0x18000000)) && ((_xgetbv(0) & 0x06) == 0x06)) {
+        __cpuidex(regs, 7, 0);
+        Xcp_ChecksumHasAvx2 = ((UINT32(regs[1]) & UINT32(0x20)) != UINT32(0)) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+    }
+#else
+    __builtin_cpu_init();
+    Xcp_ChecksumHasAvx2 = (__builtin_cpu_supports("avx2") != 0) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+#endif // _MSC_VER
+}
+
+static uint64_t Xcp_ChecksumHorizontalSum(__m128i value)
+{
+    return UINT64(_mm_cvtsi128_si64(value)) + UINT64(_mm_cvtsi128_si64(_mm_unpackhi_epi64(value, value)));
+}
+
+/*
+**  'ptr' must be 16 byte aligned, lanes[k] receives the sum of all bytes at
+**  offset k modulo the element size.
+*/
+static void Xcp_ChecksumAddSse2(uint8_t const * ptr, uint32_t blocks, uint8_t elementSize, uint64_t * lanes)
+{
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const lowByte = _mm_set1_epi16(0x00ff);
+    __m128i const lowWord = _mm_set1_epi32(0x00000001);
+    __m128i const highWord = _mm_set1_epi32(0x00010000);
+    __m128i acc[4] = { zero, zero, zero, zero };    /* Byte offset modulo 4. */
+    __m128i data;
+    __m128i even;
+    __m128i odd;
+    __m128i sum;
+    uint32_t run;
+    uint8_t k;
+
+    if (elementSize == UINT8(1)) {
+        while (blocks > UINT32(0)) {
+            data = _mm_load_si128((__m128i const *)ptr);
+            acc[0] = _mm_add_epi64(acc[0], _mm_sad_epu8(data, zero));
+            ptr += 16;
+            --blocks;
+        }
+        lanes[0] += Xcp_ChecksumHorizontalSum(acc[0]);
+        return;
+    }
+    while (blocks > UINT32(0)) {
+        run = (blocks < XCP_CHECKSUM_SIMD_RUN) ? blocks : XCP_CHECKSUM_SIMD_RUN;
+        blocks -= run;
+        even = zero;
+        odd = zero;
+        while (run > UINT32(0)) {
+            data = _mm_load_si128((__m128i const *)ptr);
+            even = _mm_add_epi16(even, _mm_and_si128(data, lowByte));
+            odd = _mm_add_epi16(odd, _mm_srli_epi16(data, 8));
+            ptr += 16;
+            --run;
+        }
+        sum = _mm_madd_epi16(even, lowWord);
+        acc[0] = _mm_add_epi64(acc[0], _mm_add_epi64(_mm_unpacklo_epi32(sum, zero), _mm_unpackhi_epi32(sum, zero)));
+        sum = _mm_madd_epi16(odd, lowWord);
+        acc[1] = _mm_add_epi64(acc[1], _mm_add_epi64(_mm_unpacklo_epi32(sum, zero), _mm_unpackhi_epi32(sum, zero)));
+        sum = _mm_madd_epi16(even, highWord);
+        acc[2] = _mm_add_epi64(acc[2], _mm_add_epi64(_mm_unpacklo_epi32(sum, zero), _mm_unpackhi_epi32(sum, zero)));
+        sum = _mm_madd_epi16(odd, highWord);
+        acc[3] = _mm_add_epi64(acc[3], _mm_add_epi64(_mm_unpacklo_epi32(sum, zero), _mm_unpackhi_epi32(sum, zero)));
+    }
+    for (k = UINT8(0); k < UINT8(4); ++k) {
+        lanes[k % elementSize] += Xcp_ChecksumHorizontalSum(acc[k]);
+    }
+}
+
+/*
+**  Same as above, 'ptr' must be 32 byte aligned.
+*/
+XCP_CHECKSUM_AVX2_TARGET static void Xcp_ChecksumAddAvx2(uint8_t const * ptr, uint32_t blocks, uint8_t elementSize, uint64_t * lanes)
+{
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const lowByte = _mm256_set1_epi16(0x00ff);
+    __m256i const lowWord = _mm256_set1_epi32(0x00000001);
+    __m256i const highWord = _mm256_set1_epi32(0x00010000);
+    __m256i acc[4] = { zero, zero, zero, zero };    /* Byte offset modulo 4. */
+    __m256i data;
+    __m256i even;
+    __m256i odd;
+    __m256i sum;
+    uint32_t run;
+    uint8_t k;
+
+    if (elementSize == UINT8(1)) {
+        while (blocks > UINT32(0)) {
+            data = _mm256_load_si256((__m256i const *)ptr);
+            acc[0] = _mm256_add_epi64(acc[0], _mm256_sad_epu8(data, zero));
+            ptr += 32;
+            --blocks;
+        }
+        lanes[0] += Xcp_ChecksumHorizontalSum(_mm_add_epi64(_mm256_castsi256_si128(acc[0]), _mm256_extracti128_si256(acc[0], 1)));
+        return;
+    }
+    while (blocks > UINT32(0)) {
+        run = (blocks < XCP_CHECKSUM_SIMD_RUN) ? blocks : XCP_CHECKSUM_SIMD_RUN;
+        blocks -= run;
+        even = zero;
+        odd = zero;
+        while (run > UINT32(0)) {
+            data = _mm256_load_si256((__m256i const *)ptr);
+            even = _mm256_add_epi16(even, _mm256_and_si256(data, lowByte));
+            odd = _mm256_add_epi16(odd, _mm256_srli_epi16(data, 8));
+            ptr += 32;
+            --run;
+        }
+        sum = _mm256_madd_epi16(even, lowWord);
+        acc[0] = _mm256_add_epi64(acc[0], _mm256_add_epi64(_mm256_unpacklo_epi32(sum, zero), _mm256_unpackhi_epi32(sum, zero)));
+        sum = _mm256_madd_epi16(odd, lowWord);
+        acc[1] = _mm256_add_epi64(acc[1], _mm256_add_epi64(_mm256_unpacklo_epi32(sum, zero), _mm256_unpackhi_epi32(sum, zero)));
+        sum = _mm256_madd_epi16(even, highWord);
+        acc[2] = _mm256_add_epi64(acc[2], _mm256_add_epi64(_mm256_unpacklo_epi32(sum, zero), _mm256_unpackhi_epi32(sum, zero)));
+        sum = _mm256_madd_epi16(odd, highWord);
+        acc[3] = _mm256_add_epi64(acc[3], _mm256_add_epi64(_mm256_unpacklo_epi32(sum, zero), _mm256_unpackhi_epi32(sum, zero)));
+    }
+    for (k = UINT8(0); k < UINT8(4); ++k) {
+        lanes[k % elementSize] += Xcp_ChecksumHorizontalSum(
+            _mm_add_epi64(_mm256_castsi256_si128(acc[k]), _mm256_extracti128_si256(acc[k], 1))
+        );
+    }
+}
+#endif // XCP_CHECKSUM_ADD_SIMD
+
+static void Xcp_ChecksumAddRange(uint8_t const * ptr, uint32_t length, uint8_t elementSize, uint64_t * sums)
+{
+    uint32_t phase = UINT32(0);
+#if defined(XCP_CHECKSUM_ADD_SIMD)
+    uint64_t lanes[XCP_CHECKSUM_MAX_ELEMENT_SIZE] = {0};
+    uint32_t const width = (Xcp_ChecksumHasAvx2 == (bool)XCP_TRUE) ? UINT32(32) : UINT32(16);
+    uint32_t head;
+    uint32_t blocks;
+    uint8_t k;
+
+    head = (width - (UINT32((uintptr_t)ptr) & (width - UINT32(1)))) & (width - UINT32(1));
+    if (length >= (head + width)) {
+        Xcp_ChecksumAddBytes(ptr, head, phase, elementSize, sums);
+        blocks = (length - head) / width;
+        if (Xcp_ChecksumHasAvx2 == (bool)XCP_TRUE) {
+            Xcp_ChecksumAddAvx2(ptr + head, blocks, elementSize, lanes);
+        } else {
+            Xcp_ChecksumAddSse2(ptr + head, blocks, elementSize, lanes);
+        }
+        for (k = UINT8(0); k < elementSize; ++k) {
+            sums[(head + k) % UINT32(elementSize)] += lanes[k];
+        }
+        phase = head + (blocks * width);
+        ptr += phase;
+        length -= phase;
+    }
+#endif // XCP_CHECKSUM_ADD_SIMD
+    Xcp_ChecksumAddBytes(ptr, length, phase, elementSize, sums);
+}
+#endif // XCP_CHECKSUM_HAS_ADD
+
+
+#if defined(XCP_CHECKSUM_HAS_HASH)
+/*
+**  User-defined method: a fast hash for large images.
+**  Every 64 byte stripe is reduced to a digest like an XXH3 accumulator
+**  (lo32(d ^ key) * hi32(d ^ key) + swapped neighbour word, over eight
+**  little-endian words), the digests are then chained by a polynomial modulo
+**  the Mersenne prime 2^61 - 1:
+**
+**      H = ((H * K) + digest) mod (2^61 - 1),  H(empty) = 0
+**
+**  A trailing partial stripe is zero-padded, hashed with a second key set and
+**  its length is added to the digest. Blocks whose length is a multiple of
+**  the stripe size can be continued from H and combined like CRCs
+**  (H(A | B) = H(A) * K^stripes(B) + H(B)). BUILD_CHECKSUM has room for
+**  32 bits only: it reports H after the XXH3 avalanche, folded to 32 bits
+**  (s. Xcp_HashFinalize()), so collisions are as likely as with any other
+**  32 bit checksum.
+*/
+#define XCP_HASH_STRIPE_SIZE    (64)
+#define XCP_HASH_PRIME          UINT64(0x1FFFFFFFFFFFFFFF)
+#define XCP_HASH_MULTIPLIER     UINT64(0x089A14506F5EDAC5)
+
+/* K^2 .. K^4: four stripes per step, so only one multiplication is serial. */
+#define XCP_HASH_MULTIPLIER_2   UINT64(0x053ED8080464CF5A)
+#define XCP_HASH_MULTIPLIER_3   UINT64(0x076D30BB81432DDB)
+#define XCP_HASH_MULTIPLIER_4   UINT64(0x18BC42BAC91F7066)
+
+static const uint64_t Xcp_HashKeys[2][8] = {
+    {   /* Full stripes. */
+        UINT64(0x959694A5475C43AD), UINT64(0x6B1B62EE39F3F3C4), UINT64(0xA9E7DC1CFEA0E586), UINT64(0xA207EC271CF39E1A),
+        UINT64(0xBB1D0A38D1F70844), UINT64(0x23AAF426BDBEB22A), UINT64(0xE7954D11B7C59185), UINT64(0x8ED3643F621FDFDA)
+    },
+    {   /* Trailing partial stripe. */
+        UINT64(0xC9A430F0659A46EB), UINT64(0x70098670B7C6F805), UINT64(0xB1464A5B11F75755), UINT64(0x54C59AE0BEBC152D),
+        UINT64(0x4A2E325FCBD2538E), UINT64(0x91C38D1EA7CD382E), UINT64(0x3E06BC5E4563BEFA), UINT64(0xA9124C6E9B9C9BA2)
+    }
+};
+
+static inline uint64_t Xcp_HashRead64(uint8_t const * ptr)
+{
+    return UINT64(ptr[0]) | (UINT64(ptr[1]) << 8) | (UINT64(ptr[2]) << 16) | (UINT64(ptr[3]) << 24) |
+           (UINT64(ptr[4]) << 32) | (UINT64(ptr[5]) << 40) | (UINT64(ptr[6]) << 48) | (UINT64(ptr[7]) << 56);
+}
+
+/*
+**  Any 64 bit value --> [0, 2^61 - 1).
+*/
+static inline uint64_t Xcp_HashReduce(uint64_t value)
+{
+    value = (value & XCP_HASH_PRIME) + (value >> 61);
+    return (value >= XCP_HASH_PRIME) ? (value - XCP_HASH_PRIME) : value;
+}
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 Xcp_HashProductType;
+
+/*
+**  a * b modulo 2^61 - 1 (a, b < 2^61).
+*/
+static inline uint64_t Xcp_HashMultMod(uint64_t a, uint64_t b)
+{
+    Xcp_HashProductType const product = (Xcp_HashProductType)a * b;
+
+    return Xcp_HashReduce(((uint64_t)product & XCP_HASH_PRIME) + (uint64_t)(product >> 61));
+}
+#else
+/*
+**  a * b modulo 2^61 - 1 (a, b < 2^61), without 128 bit arithmetic:
+**  2^64 == 2^3 and 2^61 == 1 (mod 2^61 - 1).
+*/
+static inline uint64_t Xcp_HashMultMod(uint64_t a, uint64_t b)
+{
+    uint64_t const aLow = a & UINT64(0xffffffff);
+    uint64_t const aHigh = a >> 32;
+    uint64_t const bLow = b & UINT64(0xffffffff);
+    uint64_t const bHigh = b >> 32;
+    uint64_t const middle = (aHigh * bLow) + (aLow * bHigh);
+    uint64_t const low = aLow * bLow;
+
+    return Xcp_HashReduce(
+        ((aHigh * bHigh) << 3) + (middle >> 29) + ((middle & UINT64(0x1fffffff)) << 32) +
+        (low & XCP_HASH_PRIME) + (low >> 61)
+    );
+}
+#endif // __SIZEOF_INT128__
+
+static inline uint64_t Xcp_HashStripe(uint8_t const * ptr, uint64_t const * keys)
+{
+    uint64_t digest = UINT64(0);
+    uint64_t value;
+    uint8_t idx;
+
+    for (idx = UINT8(0); idx < UINT8(8); ++idx) {
+        value = Xcp_HashRead64(ptr + (idx * UINT8(8))) ^ keys[idx];
+        digest += ((value & UINT64(0xffffffff)) * (value >> 32)) + Xcp_HashRead64(ptr + ((idx ^ UINT8(1)) * UINT8(8)));
+    }
+    return digest;
+}
+
+static uint64_t Xcp_HashUpdate(uint64_t hash, uint8_t const * ptr, uint32_t length)
+{
+    uint8_t stripe[XCP_HASH_STRIPE_SIZE];
+
+    while (length >= UINT32(4 * XCP_HASH_STRIPE_SIZE)) {
+        /* Each term is below 2^61, so the sum doesn't overflow. */
+        hash = Xcp_HashReduce(
+            Xcp_HashMultMod(hash, XCP_HASH_MULTIPLIER_4) +
+            Xcp_HashMultMod(Xcp_HashReduce(Xcp_HashStripe(ptr, Xcp_HashKeys[0])), XCP_HASH_MULTIPLIER_3) +
+            Xcp_HashMultMod(Xcp_HashReduce(Xcp_HashStripe(ptr + 64, Xcp_HashKeys[0])), XCP_HASH_MULTIPLIER_2) +
+            Xcp_HashMultMod(Xcp_HashReduce(Xcp_HashStripe(ptr + 128, Xcp_HashKeys[0])), XCP_HASH_MULTIPLIER) +
+            Xcp_HashReduce(Xcp_HashStripe(ptr + 192, Xcp_HashKeys[0]))
+        );
+        ptr += 4 * XCP_HASH_STRIPE_SIZE;
+        length -= UINT32(4 * XCP_HASH_STRIPE_SIZE);
+    }
+    while (length >= UINT32(XCP_HASH_STRIPE_SIZE)) {
+        hash = Xcp_HashReduce(Xcp_HashMultMod(hash, XCP_HASH_MULTIPLIER) + Xcp_HashReduce(Xcp_HashStripe(ptr, Xcp_HashKeys[0])));
+        ptr += XCP_HASH_STRIPE_SIZE;
+        length -= UINT32(XCP_HASH_STRIPE_SIZE);
+    }
+    if (length > UINT32(0)) {
+        Xcp_MemSet(stripe, UINT8(0), UINT32(XCP_HASH_STRIPE_SIZE));
+        Xcp_MemCopy(stripe, (void *)ptr, length);
+        hash = Xcp_HashReduce(
+            Xcp_HashMultMod(hash, XCP_HASH_MULTIPLIER) + Xcp_HashReduce(Xcp_HashStripe(stripe, Xcp_HashKeys[1]) + UINT64(length))
+        );
+    }
+    return hash;
+}
+
+static uint64_t Xcp_HashCombine(uint64_t first, uint64_t second, uint32_t secondLength)
+{
+    uint32_t stripes = (secondLength + UINT32(XCP_HASH_STRIPE_SIZE - 1)) / UINT32(XCP_HASH_STRIPE_SIZE);
+    uint64_t factor = XCP_HASH_MULTIPLIER;
+
+    while (stripes > UINT32(0)) {
+        if ((stripes & UINT32(1)) != UINT32(0)) {
+            first = Xcp_HashMultMod(first, factor);
         }
-        return reflection;
+        factor = Xcp_HashMultMod(factor, factor);
+        stripes >>= 1;
+    }
+    return Xcp_HashReduce(first + second);
 }
-#endif  // (REFLECT_DATA == TRUE) || (REFLECT_REMAINDER == TRUE)
+
+/*
+**  Applied to the response only, H itself has to stay combinable.
+*/
+static uint32_t Xcp_HashFinalize(uint64_t hash)
+{
+    hash ^= hash >> 37;
+    hash *= UINT64(0x165667919E3779F9);
+    hash ^= hash >> 32;     /* Low word = high ^ low word. */
+    return UINT32(hash);
+}
+#endif // XCP_CHECKSUM_HAS_HASH
 
 
 /*
@@ -266,79 +972,653 @@ static uint32_t reflect(uint32_t data, uint8_t nBits)
 0x06    XCP_ADD_44      Add DWORD into  DWORD, ignore overflows, blocksize must be modulo 4
 */
 
-Xcp_ChecksumType Xcp_CalculateChecksum(uint8_t const * ptr, uint32_t length, Xcp_ChecksumType startValue, bool isFirstCall)
+static Xcp_ChecksumType Xcp_ChecksumCalculate(Xcp_ChecksumMethodType const * method, uint8_t const * ptr, uint32_t length,
+                                              Xcp_ChecksumType startValue, bool isFirstCall)
 {
-    Xcp_ChecksumType result;
-    uint32_t idx;
-#if (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_16) || (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT) || \
-    (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_CRC_32)
-    uint8_t data;
+    Xcp_ChecksumType result = (Xcp_ChecksumType)0;
+#if defined(XCP_CHECKSUM_HAS_CRC)
+    uint32_t crc;
+#endif // XCP_CHECKSUM_HAS_CRC
+#if defined(XCP_CHECKSUM_HAS_ADD)
+    uint64_t sums[XCP_CHECKSUM_MAX_ELEMENT_SIZE] = {0};
+    uint8_t k;
+    uint8_t shift;
+#endif // XCP_CHECKSUM_HAS_ADD
 
-    if (isFirstCall) {
-        result = XCP_CRC_INITIAL_VALUE;
-    } else {
-        result = startValue;
+#if defined(XCP_CHECKSUM_HAS_HASH)
+    if (method->method == XCP_CHECKSUM_METHOD_XCP_USER_DEFINED) {
+        return (Xcp_ChecksumType)Xcp_HashUpdate(isFirstCall ? UINT64(0) : UINT64(startValue), ptr, length);
     }
+#endif // XCP_CHECKSUM_HAS_HASH
+#if defined(XCP_CHECKSUM_HAS_CRC)
+    if (method->crc != XCP_NULL) {
+        if (isFirstCall) {
+            crc = method->initialValue;
+        } else {
+            crc = UINT32(startValue) ^ method->finalXorValue;   /* Undo final XOR of the previous chunk. */
+        }
+        crc = Xcp_CrcToRegister(method, crc & UINT32(Xcp_ChecksumMask(method)));
+#if defined(XCP_CRC_CLMUL)
+        if ((method->method == XCP_CHECKSUM_METHOD_XCP_CRC_32) && (Xcp_CrcHasClmul == (bool)XCP_TRUE) &&
+            (length >= XCP_CRC_CLMUL_MIN_LENGTH)) {
+            uint32_t const blockLength = length & ~UINT32(15);
 
-    for (idx = (uint32_t)0UL; idx < length; ++idx)
-    {
-        data = CRC_REFLECT_DATA(ptr[idx]) ^ UINT8(result >> (WIDTH - UINT8(8)));
-        result = CRC_TAB[data] ^ UINT16(result << 8);
+            crc = Xcp_CrcFoldClmul(crc, ptr, blockLength);
+            ptr += blockLength;
+            length -= blockLength;
+        }
+#endif // XCP_CRC_CLMUL
+        if (method->reflected == (bool)XCP_TRUE) {
+            crc = Xcp_CrcUpdateReflected(method->crc, crc, ptr, length);
+        } else {
+            crc = Xcp_CrcUpdateNormal(method->crc, crc, ptr, length);
+        }
+        result = Xcp_CrcFromRegister(method, crc) ^ method->finalXorValue;
     }
-    return CRC_REFLECT_REMAINDER(result) ^ XCP_CRC_FINAL_XOR_VALUE;
-#elif (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_11) || (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_12) || \
-      (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_14)
-    if (isFirstCall) {
-        result = (Xcp_ChecksumType)0;
-    } else {
-        result = startValue;
+#endif // XCP_CHECKSUM_HAS_CRC
+#if defined(XCP_CHECKSUM_HAS_ADD)
+    if (method->crc == XCP_NULL) {
+        if (!isFirstCall) {
+            result = startValue;
+        }
+        Xcp_ChecksumAddRange(ptr, length, method->elementSize, sums);
+        for (k = UINT8(0); k < method->elementSize; ++k) {
+            shift = (XCP_BYTE_ORDER == XCP_BYTE_ORDER_INTEL) ? k : (method->elementSize - UINT8(1) - k);
+            result += (Xcp_ChecksumType)(sums[k] << (UINT8(8) * shift));
+        }
     }
+#endif // XCP_CHECKSUM_HAS_ADD
+    return result & Xcp_ChecksumMask(method);
+}
 
-    for (idx = (uint32_t)0UL; idx < length; ++idx) {
-        result += ptr[idx];
+static Xcp_ChecksumType Xcp_ChecksumCombineWith(Xcp_ChecksumMethodType const * method, Xcp_ChecksumType first,
+                                                Xcp_ChecksumType second, uint32_t secondLength)
+{
+#if defined(XCP_CHECKSUM_HAS_CRC)
+    uint32_t reg;
+#endif // XCP_CHECKSUM_HAS_CRC
+
+#if defined(XCP_CHECKSUM_HAS_HASH)
+    if (method->method == XCP_CHECKSUM_METHOD_XCP_USER_DEFINED) {
+        return (Xcp_ChecksumType)Xcp_HashCombine(UINT64(first), UINT64(second), secondLength);
+    }
+#endif // XCP_CHECKSUM_HAS_HASH
+#if defined(XCP_CHECKSUM_HAS_CRC)
+    if (method->crc != XCP_NULL) {
+        reg = Xcp_CrcToRegister(method, UINT32(first) ^ method->finalXorValue ^ method->initialValue);
+        return (Xcp_ChecksumType)(Xcp_CrcFromRegister(method, Xcp_CrcMultModP(method, Xcp_CrcShiftBytes(method, secondLength), reg)) ^
+                                  UINT32(second));
     }
+#endif // XCP_CHECKSUM_HAS_CRC
+    (void)secondLength;
+    return (Xcp_ChecksumType)((first + second) & Xcp_ChecksumMask(method));
+}
 
-    return result;
-#elif (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_22) || (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_24) || \
-      (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_44)
+Xcp_ChecksumType Xcp_CalculateChecksum(uint8_t const * ptr, uint32_t length, Xcp_ChecksumType startValue, bool isFirstCall)
+{
+    return Xcp_ChecksumCalculate(Xcp_ChecksumActiveMethod, ptr, length, startValue, isFirstCall);
+}
 
-#if (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_22) || (XCP_CHECKSUM_METHOD == XCP_CHECKSUM_METHOD_XCP_ADD_24)
-    uint16_t const * data = (uint16_t const *)ptr;  /* Undefined behaviour -  See note above */
+/** @brief Checksum of two adjacent blocks from the checksums of the blocks.
+ *
+ *  For CRCs the first value is advanced over `secondLength` zero bytes (GF(2)
+ *  multiplication by x^(8 * secondLength)), additive checksums are simply
+ *  added (the first block must then be a multiple of the element size), the
+ *  user-defined hash is advanced over the stripes of the second block (the
+ *  first block must be a multiple of 64 bytes).
+ *
+ *  @param first Checksum of the first block (as returned by Xcp_CalculateChecksum).
+ *  @param second Checksum of the second block, calculated on its own.
+ *  @param secondLength Length of the second block in bytes.
+ */
+Xcp_ChecksumType Xcp_ChecksumCombine(Xcp_ChecksumType first, Xcp_ChecksumType second, uint32_t secondLength)
+{
+    return Xcp_ChecksumCombineWith(Xcp_ChecksumActiveMethod, first, second, secondLength);
+}
+
+/** @brief Method used by BUILD_CHECKSUM (and reported in its response).
+ *
+ */
+uint8_t Xcp_GetChecksumMethod(void)
+{
+    return Xcp_ChecksumActiveMethod->method;
+}
 
-    length >>= 1;
+/** @brief Checksum as reported by BUILD_CHECKSUM.
+ *
+ *  The user-defined hash is finalized and folded to 32 bits, all other
+ *  methods fit anyway.
+ */
+uint32_t Xcp_ChecksumResponseValue(Xcp_ChecksumType checksum)
+{
+#if defined(XCP_CHECKSUM_HAS_HASH)
+    if (Xcp_ChecksumActiveMethod->method == XCP_CHECKSUM_METHOD_XCP_USER_DEFINED) {
+        return Xcp_HashFinalize(UINT64(checksum));
+    }
+    return UINT32(checksum);
 #else
-    uint32_t const * data = (uint32_t const *)ptr;  /* Undefined behaviour -  See note above */
+    return UINT32(checksum);
+#endif // XCP_CHECKSUM_HAS_HASH
+}
 
-    length >>= 2;
-#endif  /* XCP_CHECKSUM_METHOD */
-    if (isFirstCall) {
-        result = (Xcp_ChecksumType)0;
-    } else {
-        result = startValue;
+/** @brief Block sizes for BUILD_CHECKSUM must be a multiple of this.
+ *
+ */
+uint8_t Xcp_ChecksumElementSize(void)
+{
+    return Xcp_ChecksumActiveMethod->elementSize;
+}
+
+
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+/*
+**  Checksum index: registered regions are divided into blocks of
+**  XCP_CHECKSUM_INDEX_BLOCK_SIZE bytes whose checksums are cached. Write paths
+**  mark blocks dirty, BUILD_CHECKSUM over a registered range recalculates only
+**  dirty blocks and combines the cached values (Xcp_ChecksumCombine()); dirty
+**  blocks are also refreshed one per idle Xcp_ChecksumMainFunction() call.
+*/
+typedef struct tagXcp_ChecksumRegionType {
+    uint8_t const * base;
+    uint32_t size;
+    uint16_t firstBlock;
+    uint16_t numBlocks;
+} Xcp_ChecksumRegionType;
+
+static Xcp_ChecksumRegionType Xcp_ChecksumRegions[XCP_CHECKSUM_INDEX_REGIONS];
+static uint8_t Xcp_ChecksumRegionCount;
+static uint16_t Xcp_ChecksumBlockCount;
+static uint16_t Xcp_ChecksumDirtyCount;
+static Xcp_ChecksumType Xcp_ChecksumBlockValues[XCP_CHECKSUM_INDEX_BLOCKS];
+static uint8_t Xcp_ChecksumDirtyBits[(XCP_CHECKSUM_INDEX_BLOCKS + 7) / 8];
+
+static bool Xcp_ChecksumIsDirty(uint16_t block)
+{
+    return ((Xcp_ChecksumDirtyBits[block >> 3] & (UINT8(1) << (block & UINT16(7)))) != UINT8(0)) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+}
+
+static void Xcp_ChecksumSetDirty(uint16_t block)
+{
+    if (Xcp_ChecksumIsDirty(block) == (bool)XCP_FALSE) {
+        Xcp_ChecksumDirtyBits[block >> 3] |= (UINT8(1) << (block & UINT16(7)));
+        ++Xcp_ChecksumDirtyCount;
+    }
+}
+
+static uint32_t Xcp_ChecksumBlockLength(Xcp_ChecksumRegionType const * region, uint16_t idx)
+{
+    uint32_t const offset = UINT32(idx) * UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE);
+
+    return ((region->size - offset) < UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE)) ? (region->size - offset) : UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE);
+}
+
+/*
+**  Cached checksum of block 'idx' of 'region', recalculated if dirty.
+*/
+static Xcp_ChecksumType Xcp_ChecksumBlockValue(Xcp_ChecksumRegionType const * region, uint16_t idx)
+{
+    uint16_t const block = region->firstBlock + idx;
+
+    if (Xcp_ChecksumIsDirty(block) == (bool)XCP_TRUE) {
+        Xcp_ChecksumBlockValues[block] = Xcp_CalculateChecksum(
+            region->base + (UINT32(idx) * UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE)),
+            Xcp_ChecksumBlockLength(region, idx), (Xcp_ChecksumType)0, XCP_TRUE
+        );
+        Xcp_ChecksumDirtyBits[block >> 3] &= UINT8(~(UINT8(1) << (block & UINT16(7))));
+        --Xcp_ChecksumDirtyCount;
     }
+    return Xcp_ChecksumBlockValues[block];
+}
 
-    for (idx = (uint32_t)0UL; idx < length; ++idx) {
-        result += data[idx];
+static void Xcp_ChecksumIndexInit(void)
+{
+    Xcp_ChecksumRegionCount = UINT8(0);
+    Xcp_ChecksumBlockCount = UINT16(0);
+    Xcp_ChecksumDirtyCount = UINT16(0);
+    Xcp_MemSet(Xcp_ChecksumDirtyBits, UINT8(0), UINT32(sizeof(Xcp_ChecksumDirtyBits)));
+}
+
+/*
+**  Cached values belong to the active method.
+*/
+static void Xcp_ChecksumInvalidateIndex(void)
+{
+    uint16_t block;
+
+    for (block = UINT16(0); block < Xcp_ChecksumBlockCount; ++block) {
+        Xcp_ChecksumSetDirty(block);
     }
+}
 
-    return result;
-#endif /* XCP_CHECKSUM_METHOD */
+/*
+**  Recalculate the first dirty block, if any.
+*/
+static void Xcp_ChecksumRefreshIndex(void)
+{
+    uint8_t rIdx;
+    uint16_t idx;
+    Xcp_ChecksumRegionType const * region;
+
+    if (Xcp_ChecksumDirtyCount == UINT16(0)) {
+        return;
+    }
+    for (rIdx = UINT8(0); rIdx < Xcp_ChecksumRegionCount; ++rIdx) {
+        region = &Xcp_ChecksumRegions[rIdx];
+        for (idx = UINT16(0); idx < region->numBlocks; ++idx) {
+            if (Xcp_ChecksumIsDirty(region->firstBlock + idx) == (bool)XCP_TRUE) {
+                (void)Xcp_ChecksumBlockValue(region, idx);
+                return;
+            }
+        }
+    }
+}
+
+/** @brief Register a memory region for incremental checksum calculation.
+ *
+ *  All blocks start dirty. Writes to the region that don't go through
+ *  DOWNLOAD, SHORT_DOWNLOAD, MODIFY_BITS or STIM must be reported with
+ *  Xcp_ChecksumMarkDirty().
+ *
+ *  @return XCP_FALSE if there are no free region resp. block slots left.
+ */
+bool Xcp_ChecksumRegisterRegion(uint8_t const * base, uint32_t size)
+{
+    uint32_t numBlocks = (size + UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE - 1)) / UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE);
+    Xcp_ChecksumRegionType * region;
+    uint16_t idx;
+
+    if ((Xcp_ChecksumRegionCount >= UINT8(XCP_CHECKSUM_INDEX_REGIONS)) ||
+        (numBlocks > (UINT32(XCP_CHECKSUM_INDEX_BLOCKS) - UINT32(Xcp_ChecksumBlockCount)))) {
+        return (bool)XCP_FALSE;
+    }
+    region = &Xcp_ChecksumRegions[Xcp_ChecksumRegionCount];
+    region->base = base;
+    region->size = size;
+    region->firstBlock = Xcp_ChecksumBlockCount;
+    region->numBlocks = UINT16(numBlocks);
+    for (idx = UINT16(0); idx < region->numBlocks; ++idx) {
+        Xcp_ChecksumSetDirty(region->firstBlock + idx);
+    }
+    Xcp_ChecksumBlockCount += UINT16(numBlocks);
+    ++Xcp_ChecksumRegionCount;
+    return (bool)XCP_TRUE;
 }
 
+/** @brief Invalidate cached block checksums overlapping [ptr, ptr + length).
+ *
+ */
+void Xcp_ChecksumMarkDirty(uint8_t const * ptr, uint32_t length)
+{
+    uint8_t rIdx;
+    uint32_t first;
+    uint32_t last;
+    uint32_t offset;
+    Xcp_ChecksumRegionType const * region;
 
-#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON && XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+    if (length == UINT32(0)) {
+        return;
+    }
+    for (rIdx = UINT8(0); rIdx < Xcp_ChecksumRegionCount; ++rIdx) {
+        region = &Xcp_ChecksumRegions[rIdx];
+        if ((ptr >= (region->base + region->size)) || ((ptr + length) <= region->base)) {
+            continue;
+        }
+        offset = (ptr > region->base) ? UINT32(ptr - region->base) : UINT32(0);
+        first = offset / UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE);
+        offset = ((ptr + length) < (region->base + region->size)) ? UINT32((ptr + length) - region->base) : region->size;
+        last = (offset - UINT32(1)) / UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE);
+        for (; first <= last; ++first) {
+            Xcp_ChecksumSetDirty(region->firstBlock + UINT16(first));
+        }
+    }
+}
+
+#if XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+/*
+**  Number of bytes Xcp_ChecksumFromIndex() would have to calculate.
+*/
+static uint32_t Xcp_ChecksumPendingBytes(Xcp_ChecksumRegionType const * region, uint16_t idx, uint32_t offset, uint32_t size)
+{
+    uint32_t pending = UINT32(0);
+    uint32_t length;
+    uint32_t blockLength;
+
+    while (size > UINT32(0)) {
+        blockLength = Xcp_ChecksumBlockLength(region, idx);
+        if ((offset == UINT32(0)) && (size >= blockLength)) {
+            length = blockLength;
+            if (Xcp_ChecksumIsDirty(region->firstBlock + idx) == (bool)XCP_TRUE) {
+                pending += length;
+            }
+        } else {
+            length = ((blockLength - offset) < size) ? (blockLength - offset) : size;
+            pending += length;
+        }
+        size -= length;
+        offset = UINT32(0);
+        ++idx;
+    }
+    return pending;
+}
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+
+/** @brief Checksum of a range inside a registered region, from cached block values.
+ *
+ *  Only dirty blocks and partially covered blocks at the ends are calculated.
+ *
+ *  @return XCP_FALSE if the range isn't covered by a single region (or, for
+ *          additive checksums resp. the hash, doesn't start on an element
+ *          resp. stripe boundary of it), or if more than
+ *          XCP_CHECKSUM_INDEX_MAX_DIRTY bytes would have to be calculated
+ *          (chunked calculation only, the caller starts the background job).
+ */
+bool Xcp_ChecksumFromIndex(uint8_t const * ptr, uint32_t size, Xcp_ChecksumType * result)
+{
+    Xcp_ChecksumRegionType const * region = (Xcp_ChecksumRegionType const *)XCP_NULL;
+    Xcp_ChecksumType value;
+    Xcp_ChecksumType checksum = (Xcp_ChecksumType)0;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t blockLength;
+    uint16_t idx;
+    uint8_t rIdx;
+    bool isFirst = (bool)XCP_TRUE;
+
+    for (rIdx = UINT8(0); rIdx < Xcp_ChecksumRegionCount; ++rIdx) {
+        if ((ptr >= Xcp_ChecksumRegions[rIdx].base) &&
+            (size <= Xcp_ChecksumRegions[rIdx].size) &&
+            (UINT32(ptr - Xcp_ChecksumRegions[rIdx].base) <= (Xcp_ChecksumRegions[rIdx].size - size))) {
+            region = &Xcp_ChecksumRegions[rIdx];
+            break;
+        }
+    }
+    if ((region == (Xcp_ChecksumRegionType const *)XCP_NULL) || (size == UINT32(0))) {
+        return (bool)XCP_FALSE;
+    }
+    offset = UINT32(ptr - region->base);
+    if ((offset % UINT32(Xcp_ChecksumActiveMethod->granularity)) != UINT32(0)) {
+        return (bool)XCP_FALSE;
+    }
+    idx = UINT16(offset / UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE));
+    offset %= UINT32(XCP_CHECKSUM_INDEX_BLOCK_SIZE);
+#if XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+    if (Xcp_ChecksumPendingBytes(region, idx, offset, size) > UINT32(XCP_CHECKSUM_INDEX_MAX_DIRTY)) {
+        return (bool)XCP_FALSE;
+    }
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+    while (size > UINT32(0)) {
+        blockLength = Xcp_ChecksumBlockLength(region, idx);
+        if ((offset == UINT32(0)) && (size >= blockLength)) {
+            length = blockLength;
+            value = Xcp_ChecksumBlockValue(region, idx);
+        } else {
+            length = ((blockLength - offset) < size) ? (blockLength - offset) : size;
+            value = Xcp_CalculateChecksum(ptr, length, (Xcp_ChecksumType)0, XCP_TRUE);
+        }
+        checksum = (isFirst == (bool)XCP_TRUE) ? value : Xcp_ChecksumCombine(checksum, value, length);
+        isFirst = (bool)XCP_FALSE;
+        ptr += length;
+        size -= length;
+        offset = UINT32(0);
+        ++idx;
+    }
+    *result = checksum;
+    return (bool)XCP_TRUE;
+}
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+
+
+#if XCP_ENABLE_BUILD_CHECKSUM == XCP_ON
+#if XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
 static Xcp_ChecksumJobType Xcp_ChecksumJob;
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
 
 void Xcp_ChecksumInit(void)
 {
-    Xcp_ChecksumJob.mta.address = UINT32(0ul);
-    Xcp_ChecksumJob.mta.ext = UINT8(0);
+    uint8_t idx;
+
+    for (idx = UINT8(0); idx < XCP_CHECKSUM_NUM_METHODS; ++idx) {
+#if defined(XCP_CHECKSUM_HAS_CRC)
+        if (Xcp_ChecksumMethods[idx].crc != XCP_NULL) {
+            Xcp_CrcGenerateTables(&Xcp_ChecksumMethods[idx]);
+        }
+#endif // XCP_CHECKSUM_HAS_CRC
+        if (Xcp_ChecksumMethods[idx].method == UINT8(XCP_CHECKSUM_METHOD)) {
+            Xcp_ChecksumActiveMethod = &Xcp_ChecksumMethods[idx];
+        }
+    }
+#if defined(XCP_CRC_CLMUL)
+    Xcp_CrcDetectClmul();
+#endif // XCP_CRC_CLMUL
+#if defined(XCP_CHECKSUM_ADD_SIMD)
+    Xcp_ChecksumDetectAvx2();
+#endif // XCP_CHECKSUM_ADD_SIMD
+#if XCP_CHECKSUM_WORKER_THREAD == XCP_ON
+    Xcp_ChecksumCancel();
+#endif // XCP_CHECKSUM_WORKER_THREAD
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+    Xcp_ChecksumIndexInit();
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+#if XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+    Xcp_ChecksumJob.ptr = (uint8_t const *)XCP_NULL;
     Xcp_ChecksumJob.interimChecksum = (Xcp_ChecksumType)0ul;
     Xcp_ChecksumJob.size = UINT32(0ul);
+    Xcp_ChecksumJob.chunkSize = UINT32(XCP_CHECKSUM_CHUNK_SIZE);
     Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_IDLE;
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+}
+
+#if XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+
+#if XCP_CHECKSUM_WORKER_THREAD == XCP_ON
+/*
+**  The whole block is checksummed by a worker thread, in slices so progress
+**  can be reported and a cancelled job is abandoned early. The result is
+**  posted to a completion slot that Xcp_ChecksumMainFunction() polls from the
+**  command context. Only commands that conflict with the job are rejected
+**  meanwhile (s. Xcp_ChecksumIsPending()), Xcp_SetBusy() isn't used.
+*/
+#define XCP_CHECKSUM_WORKER_SLICE   UINT32(0x00100000)
+
+typedef struct tagXcp_ChecksumWorkerType {
+    pthread_mutex_t lock;
+    pthread_cond_t wakeup;
+    bool running;           /* Fields below are guarded by 'lock'. */
+    bool posted;
+    bool done;
+    uint32_t jobId;         /* Incremented for every job resp. cancellation. */
+    Xcp_ChecksumMethodType const * method;
+    uint8_t const * ptr;
+    uint32_t size;
+    uint32_t remaining;
+    Xcp_ChecksumType result;
+} Xcp_ChecksumWorkerType;
+
+static Xcp_ChecksumWorkerType Xcp_ChecksumWorker = {
+    .lock = PTHREAD_MUTEX_INITIALIZER, .wakeup = PTHREAD_COND_INITIALIZER
+};
+
+typedef struct tagXcp_ChecksumPartType {
+    Xcp_ChecksumMethodType const * method;
+    uint8_t const * ptr;
+    uint32_t size;
+    uint32_t jobId;
+    bool cancelled;
+    Xcp_ChecksumType result;
+} Xcp_ChecksumPartType;
+
+/*
+**  Checksum one part of a job in slices, gives up as soon as the job is cancelled.
+*/
+static void Xcp_ChecksumWorkerRun(Xcp_ChecksumPartType * part)
+{
+    uint8_t const * ptr = part->ptr;
+    uint32_t size = part->size;
+    uint32_t length;
+    bool isFirstCall = (bool)XCP_TRUE;
+
+    part->result = (Xcp_ChecksumType)0;
+    part->cancelled = (bool)XCP_FALSE;
+    while ((size > UINT32(0)) && (part->cancelled == (bool)XCP_FALSE)) {
+        length = (size < XCP_CHECKSUM_WORKER_SLICE) ? size : XCP_CHECKSUM_WORKER_SLICE;
+        part->result = Xcp_ChecksumCalculate(part->method, ptr, length, part->result, isFirstCall);
+        isFirstCall = (bool)XCP_FALSE;
+        ptr += length;
+        size -= length;
+        pthread_mutex_lock(&Xcp_ChecksumWorker.lock);
+        if (part->jobId == Xcp_ChecksumWorker.jobId) {
+            Xcp_ChecksumWorker.remaining -= length;
+        } else {
+            part->cancelled = (bool)XCP_TRUE;
+        }
+        pthread_mutex_unlock(&Xcp_ChecksumWorker.lock);
+    }
+}
+
+static void * Xcp_ChecksumHelperThread(void * arg)
+{
+    Xcp_ChecksumWorkerRun((Xcp_ChecksumPartType *)arg);
+    return NULL;
+}
+
+/*
+**  Blocks of at least XCP_CHECKSUM_PARALLEL_THRESHOLD bytes are split into
+**  XCP_CHECKSUM_WORKER_THREADS parts (multiples of 64 bytes), checksummed
+**  concurrently and merged with Xcp_ChecksumCombine().
+*/
+static void * Xcp_ChecksumWorkerThread(void * arg)
+{
+    Xcp_ChecksumPartType parts[XCP_CHECKSUM_WORKER_THREADS];
+    pthread_t helpers[XCP_CHECKSUM_WORKER_THREADS];
+    bool spawned[XCP_CHECKSUM_WORKER_THREADS];
+    Xcp_ChecksumMethodType const * method;
+    uint8_t const * ptr;
+    uint32_t size;
+    uint32_t partSize;
+    uint32_t jobId;
+    Xcp_ChecksumType checksum;
+    bool cancelled;
+    uint8_t numParts;
+    uint8_t idx;
+
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&Xcp_ChecksumWorker.lock);
+        while (Xcp_ChecksumWorker.posted == (bool)XCP_FALSE) {
+            pthread_cond_wait(&Xcp_ChecksumWorker.wakeup, &Xcp_ChecksumWorker.lock);
+        }
+        Xcp_ChecksumWorker.posted = (bool)XCP_FALSE;
+        method = Xcp_ChecksumWorker.method;
+        ptr = Xcp_ChecksumWorker.ptr;
+        size = Xcp_ChecksumWorker.size;
+        jobId = Xcp_ChecksumWorker.jobId;
+        pthread_mutex_unlock(&Xcp_ChecksumWorker.lock);
+
+        numParts = (size >= UINT32(XCP_CHECKSUM_PARALLEL_THRESHOLD)) ? UINT8(XCP_CHECKSUM_WORKER_THREADS) : UINT8(1);
+        partSize = (size / UINT32(numParts)) & ~UINT32(63);
+        for (idx = UINT8(0); idx < numParts; ++idx) {
+            parts[idx].method = method;
+            parts[idx].ptr = ptr + (partSize * UINT32(idx));
+            parts[idx].size = (idx == (numParts - UINT8(1))) ? (size - (partSize * UINT32(idx))) : partSize;
+            parts[idx].jobId = jobId;
+        }
+        for (idx = UINT8(1); idx < numParts; ++idx) {
+            spawned[idx] = (pthread_create(&helpers[idx], NULL, Xcp_ChecksumHelperThread, &parts[idx]) == 0) ?
+                (bool)XCP_TRUE : (bool)XCP_FALSE;
+        }
+        Xcp_ChecksumWorkerRun(&parts[0]);
+        checksum = parts[0].result;
+        cancelled = parts[0].cancelled;
+        for (idx = UINT8(1); idx < numParts; ++idx) {
+            if (spawned[idx] == (bool)XCP_TRUE) {
+                pthread_join(helpers[idx], NULL);
+            } else {
+                Xcp_ChecksumWorkerRun(&parts[idx]);
+            }
+            checksum = Xcp_ChecksumCombineWith(method, checksum, parts[idx].result, parts[idx].size);
+            cancelled = (parts[idx].cancelled == (bool)XCP_TRUE) ? (bool)XCP_TRUE : cancelled;
+        }
+
+        pthread_mutex_lock(&Xcp_ChecksumWorker.lock);
+        if ((jobId == Xcp_ChecksumWorker.jobId) && (cancelled == (bool)XCP_FALSE)) {
+            Xcp_ChecksumWorker.result = checksum;
+            Xcp_ChecksumWorker.done = (bool)XCP_TRUE;
+        }
+        pthread_mutex_unlock(&Xcp_ChecksumWorker.lock);
+    }
+    return NULL;
 }
 
+void Xcp_StartChecksumCalculation(uint8_t const * ptr, uint32_t size)
+{
+    pthread_t thread;
+
+    if (Xcp_ChecksumJob.state != XCP_CHECKSUM_STATE_IDLE) {
+        return;
+    }
+    pthread_mutex_lock(&Xcp_ChecksumWorker.lock);
+    if (Xcp_ChecksumWorker.running == (bool)XCP_FALSE) {
+        if (pthread_create(&thread, NULL, Xcp_ChecksumWorkerThread, NULL) != 0) {
+            pthread_mutex_unlock(&Xcp_ChecksumWorker.lock);
+            /* No thread, no background calculation. */
+            Xcp_SendChecksumPositiveResponse(Xcp_CalculateChecksum(ptr, size, (Xcp_ChecksumType)0, XCP_TRUE));
+            return;
+        }
+        pthread_detach(thread);
+        Xcp_ChecksumWorker.running = (bool)XCP_TRUE;
+    }
+    ++Xcp_ChecksumWorker.jobId;
+    Xcp_ChecksumWorker.method = Xcp_ChecksumActiveMethod;
+    Xcp_ChecksumWorker.ptr = ptr;
+    Xcp_ChecksumWorker.size = size;
+    Xcp_ChecksumWorker.remaining = size;
+    Xcp_ChecksumWorker.done = (bool)XCP_FALSE;
+    Xcp_ChecksumWorker.posted = (bool)XCP_TRUE;
+    pthread_cond_signal(&Xcp_ChecksumWorker.wakeup);
+    pthread_mutex_unlock(&Xcp_ChecksumWorker.lock);
+    Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_RUNNING_INITIAL;
+}
+
+/** @brief Deliver the result of a background checksum calculation.
+ *
+ *  @return Number of bytes still to be processed (0 if no calculation is pending).
+ */
+uint32_t Xcp_ChecksumMainFunction(void)
+{
+    bool done;
+    uint32_t remaining;
+    Xcp_ChecksumType checksum;
+
+    if (Xcp_ChecksumJob.state == XCP_CHECKSUM_STATE_IDLE) {
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+        Xcp_ChecksumRefreshIndex();
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+        return UINT32(0);
+    }
+    pthread_mutex_lock(&Xcp_ChecksumWorker.lock);
+    done = Xcp_ChecksumWorker.done;
+    Xcp_ChecksumWorker.done = (bool)XCP_FALSE;
+    remaining = Xcp_ChecksumWorker.remaining;
+    checksum = Xcp_ChecksumWorker.result;
+    pthread_mutex_unlock(&Xcp_ChecksumWorker.lock);
+    if (done == (bool)XCP_FALSE) {
+        return (remaining > UINT32(0)) ? remaining : UINT32(1);
+    }
+    Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_IDLE;
+    Xcp_SendChecksumPositiveResponse(checksum);
+    return UINT32(0);
+}
 
+void Xcp_ChecksumCancel(void)
+{
+    pthread_mutex_lock(&Xcp_ChecksumWorker.lock);
+    ++Xcp_ChecksumWorker.jobId;
+    Xcp_ChecksumWorker.posted = (bool)XCP_FALSE;
+    Xcp_ChecksumWorker.done = (bool)XCP_FALSE;
+    pthread_mutex_unlock(&Xcp_ChecksumWorker.lock);
+    Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_IDLE;
+}
+#else
 void Xcp_StartChecksumCalculation(uint8_t const * ptr, uint32_t size)
 {
     XCP_ENTER_CRITICAL();
@@ -349,45 +1629,126 @@ void Xcp_StartChecksumCalculation(uint8_t const * ptr, uint32_t size)
     Xcp_SetBusy(XCP_TRUE);
     Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_RUNNING_INITIAL;
     //printf("S-Address: %p Size: %u\n", ptr, size);
-    Xcp_ChecksumJob.mta.address = (uint32_t)ptr;
+    Xcp_ChecksumJob.ptr = ptr;
     Xcp_ChecksumJob.size = size;
     XCP_LEAVE_CRITICAL();
 }
 
+#if XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET > 0
+/*
+**  Scale the chunk so that the next call takes about 3/4 of the budget. Growth
+**  is limited to 4x per call, because coarse timers report zero ticks for small
+**  chunks. Chunks stay multiples of 64 bytes (element size and SIMD width).
+*/
+static void Xcp_ChecksumAdaptChunkSize(uint32_t elapsed)
+{
+    uint64_t const current = UINT64(Xcp_ChecksumJob.chunkSize);
+    uint64_t next;
+
+    if (elapsed == UINT32(0)) {
+        next = current * UINT64(4);
+    } else {
+        next = (current * UINT64(XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET) * UINT64(3)) / (UINT64(elapsed) * UINT64(4));
+        if (next > (current * UINT64(4))) {
+            next = current * UINT64(4);
+        }
+    }
+    next &= ~UINT64(63);
+    if (next < UINT64(XCP_CHECKSUM_CHUNK_SIZE)) {
+        next = UINT64(XCP_CHECKSUM_CHUNK_SIZE);
+    } else if (next > UINT64(0x40000000)) {
+        next = UINT64(0x40000000);
+    }
+    Xcp_ChecksumJob.chunkSize = UINT32(next);
+}
+#endif // XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET
+
 /** @brief Do lengthy checksum/CRC calculations in the background.
  *
+ *  Processes one chunk per call; with `XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET`
+ *  the chunk size follows the measured throughput to fill the budget.
  *
+ *  @return Number of bytes still to be processed (0 if no calculation is pending).
  */
-void Xcp_ChecksumMainFunction(void)
+uint32_t Xcp_ChecksumMainFunction(void)
 {
+    uint32_t length;
+#if XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET > 0
+    uint32_t start;
+#endif // XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET
+
     if (Xcp_ChecksumJob.state == XCP_CHECKSUM_STATE_IDLE) {
-        return;
-    } else if (Xcp_ChecksumJob.state == XCP_CHECKSUM_STATE_RUNNING_INITIAL) {
-         Xcp_ChecksumJob.interimChecksum = Xcp_CalculateChecksum(
-            (uint8_t const *)Xcp_ChecksumJob.mta.address, XCP_CHECKSUM_CHUNK_SIZE, (Xcp_ChecksumType)0, XCP_TRUE
-         );
-        Xcp_ChecksumJob.size -= XCP_CHECKSUM_CHUNK_SIZE;
-        Xcp_ChecksumJob.mta.address += XCP_CHECKSUM_CHUNK_SIZE;
-         Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_RUNNING_REMAINING;
-    } else if (Xcp_ChecksumJob.state == XCP_CHECKSUM_STATE_RUNNING_REMAINING) {
-        Xcp_ChecksumJob.interimChecksum = Xcp_CalculateChecksum(
-            (uint8_t const *)Xcp_ChecksumJob.mta.address, XCP_CHECKSUM_CHUNK_SIZE, Xcp_ChecksumJob.interimChecksum, XCP_FALSE
-        );
-        //printf("N-Address: %x Size: %u CS: %x\n", Xcp_ChecksumJob.mta.address, Xcp_ChecksumJob.size, Xcp_ChecksumJob.interimChecksum);
-        Xcp_ChecksumJob.size -= XCP_CHECKSUM_CHUNK_SIZE;
-        Xcp_ChecksumJob.mta.address += XCP_CHECKSUM_CHUNK_SIZE;
-        if (Xcp_ChecksumJob.size <= XCP_CHECKSUM_CHUNK_SIZE) {
-            Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_RUNNING_FINAL;
-        }
-    }  else if (Xcp_ChecksumJob.state == XCP_CHECKSUM_STATE_RUNNING_FINAL) {
-        //printf("F-Address: %x Size: %u CS: %x\n", Xcp_ChecksumJob.mta.address, Xcp_ChecksumJob.size, Xcp_ChecksumJob.interimChecksum);
-        Xcp_ChecksumJob.interimChecksum = Xcp_CalculateChecksum(
-            (uint8_t const *)Xcp_ChecksumJob.mta.address, Xcp_ChecksumJob.size, Xcp_ChecksumJob.interimChecksum, XCP_FALSE
-        );
-        //printf("FINAL-VALUE %x\n", Xcp_ChecksumJob.interimChecksum);
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+        Xcp_ChecksumRefreshIndex();
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+        return UINT32(0);
+    }
+    length = (Xcp_ChecksumJob.size < Xcp_ChecksumJob.chunkSize) ? Xcp_ChecksumJob.size : Xcp_ChecksumJob.chunkSize;
+#if XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET > 0
+    start = XcpHw_GetTimerCounter();
+#endif // XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET
+    Xcp_ChecksumJob.interimChecksum = Xcp_CalculateChecksum(
+        Xcp_ChecksumJob.ptr, length, Xcp_ChecksumJob.interimChecksum,
+        (Xcp_ChecksumJob.state == XCP_CHECKSUM_STATE_RUNNING_INITIAL) ? (bool)XCP_TRUE : (bool)XCP_FALSE
+    );
+#if XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET > 0
+    if (length == Xcp_ChecksumJob.chunkSize) {
+        Xcp_ChecksumAdaptChunkSize(XcpHw_GetTimerCounter() - start);
+    }
+#endif // XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET
+    Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_RUNNING_REMAINING;
+    Xcp_ChecksumJob.size -= length;
+    Xcp_ChecksumJob.ptr += length;
+    if (Xcp_ChecksumJob.size == UINT32(0)) {
         Xcp_SetBusy(XCP_FALSE);
         Xcp_SendChecksumPositiveResponse(Xcp_ChecksumJob.interimChecksum);
         Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_IDLE;
     }
+    return Xcp_ChecksumJob.size;
+}
+
+void Xcp_ChecksumCancel(void)
+{
+    if (Xcp_ChecksumJob.state != XCP_CHECKSUM_STATE_IDLE) {
+        Xcp_ChecksumJob.state = XCP_CHECKSUM_STATE_IDLE;
+        Xcp_SetBusy(XCP_FALSE);
+    }
+}
+#endif // XCP_CHECKSUM_WORKER_THREAD
+
+bool Xcp_ChecksumIsPending(void)
+{
+    return (Xcp_ChecksumJob.state != XCP_CHECKSUM_STATE_IDLE) ? (bool)XCP_TRUE : (bool)XCP_FALSE;
+}
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+
+/** @brief Select the checksum method for the current session.
+ *
+ *  Available are `XCP_CHECKSUM_METHOD` (the default, restored on `CONNECT`)
+ *  and the methods in `XCP_CHECKSUM_METHODS`.
+ *
+ *  @return XCP_FALSE if the method isn't available or a calculation is pending.
+ */
+bool Xcp_SetChecksumMethod(uint8_t method)
+{
+    uint8_t idx;
+
+#if XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON
+    if (Xcp_ChecksumIsPending()) {
+        return (bool)XCP_FALSE;
+    }
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+    for (idx = UINT8(0); idx < XCP_CHECKSUM_NUM_METHODS; ++idx) {
+        if (Xcp_ChecksumMethods[idx].method == method) {
+            if (Xcp_ChecksumActiveMethod != &Xcp_ChecksumMethods[idx]) {
+                Xcp_ChecksumActiveMethod = &Xcp_ChecksumMethods[idx];
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+                Xcp_ChecksumInvalidateIndex();
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+            }
+            return (bool)XCP_TRUE;
+        }
+    }
+    return (bool)XCP_FALSE;
 }
 #endif // XCP_ENABLE_BUILD_CHECKSUM
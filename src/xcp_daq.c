@@ -33,6 +33,9 @@
 
 #define NUM_DAQ_ENTITIES    (256)
 
+#define XCP_DAQ_FNV_OFFSET_BASIS    UINT32(0x811C9DC5)
+#define XCP_DAQ_FNV_PRIME           UINT32(0x01000193)
+
 
 /*
 ** Local Types.
@@ -62,6 +65,77 @@ typedef enum tagXcpDaq_ListTransitionType {
     DAQ_LIST_TRANSITION_STOP
 } XcpDaq_ListTransitionType;
 
+/*
+**  The gather plan is the validated, ready-to-sample form of the DAQ configuration.
+**  It is compiled once (on START_STOP_SYNCH) and replaced whenever the
+**  configuration changes, so sampling needs neither range nor access checks.
+**  Lists failing validation are left out (status != ERR_SUCCESS) and can't be
+**  started; the other lists are not affected.
+*/
+typedef struct tagXcpDaq_GatherDescriptorType {
+    uint8_t * address;
+    uint16_t length;
+    bool device;            /* s. XCP_MEMORY_REGION_DEVICE */
+} XcpDaq_GatherDescriptorType;
+
+typedef struct tagXcpDaq_GatherOdtType {
+    uint16_t firstDescriptor;
+    uint16_t numDescriptors;
+} XcpDaq_GatherOdtType;
+
+typedef struct tagXcpDaq_GatherListType {
+    Xcp_ReturnType status;
+    uint8_t firstPid;
+    XcpDaq_ODTIntegerType numOdts;
+} XcpDaq_GatherListType;
+
+typedef struct tagXcpDaq_GatherPidType {
+    XcpDaq_ListIntegerType daqList;
+    XcpDaq_ODTIntegerType odt;
+} XcpDaq_GatherPidType;
+
+/*
+**  Per DAQ entity, the part of the configuration a plan depends on:
+**  a cache hit is only taken if the keys match, not just the fingerprint.
+*/
+typedef struct tagXcpDaq_GatherKeyType {
+    uint32_t address;       /* List: first ODT, ODT: first entry, entry: MTA. */
+    uint32_t length;        /* List: ODTs, ODT: entries, entry: bytes. */
+    uint8_t kind;
+    uint8_t ext;
+    uint8_t mode;           /* Mode bits the plan depends on. */
+    uint8_t epoch;
+} XcpDaq_GatherKeyType;
+
+/*
+**  Sampled DTOs wait here (header bytes included) until XcpDaq_MainFunction()
+**  hands them to the transport-layer. `count` includes slots reserved by a
+**  sample still being filled; they are sent once `ready`.
+*/
+typedef struct tagXcpDaq_QueueType {
+    uint16_t head;
+    uint16_t tail;
+    uint16_t count;
+    bool ready[XCP_DAQ_QUEUE_SIZE];
+    uint16_t length[XCP_DAQ_QUEUE_SIZE];
+    uint8_t frame[XCP_DAQ_QUEUE_SIZE][XCP_MAX_DTO + 4];
+} XcpDaq_QueueType;
+
+typedef struct tagXcpDaq_GatherPlanType {
+    bool valid;             /* Slot holds a successfully compiled plan. */
+    uint8_t users;          /* Events sampling with this plan, s. XcpDaq_AcquireGatherPlan(). */
+    uint32_t fingerprint;   /* Configuration the plan was compiled from. */
+    uint32_t lastUsed;
+    uint16_t numPids;
+    uint16_t numLists;
+    uint16_t numEntities;
+    XcpDaq_GatherKeyType keys[NUM_DAQ_ENTITIES];
+    XcpDaq_GatherListType lists[NUM_DAQ_ENTITIES];
+    XcpDaq_GatherPidType pids[NUM_DAQ_ENTITIES];
+    XcpDaq_GatherOdtType odts[NUM_DAQ_ENTITIES];   /* Indexed by PID. */
+    XcpDaq_GatherDescriptorType descriptors[NUM_DAQ_ENTITIES];
+} XcpDaq_GatherPlanType;
+
 /*
 ** Local Constants.
 */
@@ -83,6 +157,11 @@ static XcpDaq_EntityType XcpDaq_Entities[NUM_DAQ_ENTITIES];
 static uint16_t XcpDaq_EntityCount = UINT16(0);
 static uint16_t XcpDaq_ListCount = UINT16(0);
 static uint16_t XcpDaq_OdtCount = UINT16(0);
+static XcpDaq_GatherPlanType XcpDaq_GatherPlanCache[XCP_DAQ_PLAN_CACHE_SIZE];
+static XcpDaq_GatherPlanType * XcpDaq_GatherPlan = (XcpDaq_GatherPlanType *)XCP_NULL;    /* Active plan. */
+static uint32_t XcpDaq_PlanUseCounter = UINT32(0);
+static uint32_t XcpDaq_Fingerprint = XCP_DAQ_FNV_OFFSET_BASIS;
+static XcpDaq_QueueType XcpDaq_Queue;
 
 #if XCP_DAQ_MULTIPLE_DAQ_LISTS_PER_EVENT_SUPPORTED  == XCP_OFF
 static uint8_t XcpDaq_ListForEvent[XCP_DAQ_MAX_EVENT_CHANNEL];
@@ -99,6 +178,20 @@ static bool XcpDaq_AllocValidateTransition(XcpDaq_AllocTransitionype transition)
 static XcpDaq_ListIntegerType XcpDaq_GetDynamicListCount(void);
 void XcpDaq_DumpEntities(void);
 static void XcpDaq_StartStopLists(XcpDaq_ListTransitionType transition);
+static bool XcpDaq_AnyListStarted(void);
+static void XcpDaq_SampleList(XcpDaq_GatherPlanType const * plan, XcpDaq_ListIntegerType daqListNumber, XcpDaq_ListType const * daqList);
+static void XcpDaq_QueueInit(void);
+static void XcpDaq_BuildGatherPlan(XcpDaq_GatherPlanType * plan);
+static Xcp_ReturnType XcpDaq_BuildGatherList(XcpDaq_GatherPlanType * plan, XcpDaq_ListIntegerType listIdx, uint16_t * numDescriptors);
+static Xcp_ReturnType XcpDaq_GetListStatus(XcpDaq_ListIntegerType daqListNumber);
+static void XcpDaq_DropGatherPlan(void);
+static XcpDaq_GatherPlanType * XcpDaq_FindCachedPlan(void);
+static XcpDaq_GatherPlanType * XcpDaq_FindFreeSlot(void);
+static void XcpDaq_GetGatherKey(uint16_t idx, XcpDaq_GatherKeyType * key);
+static bool XcpDaq_PlanMatches(XcpDaq_GatherPlanType const * plan);
+static XcpDaq_GatherPlanType * XcpDaq_AcquireGatherPlan(void);
+static void XcpDaq_ReleaseGatherPlan(XcpDaq_GatherPlanType * plan);
+static void XcpDaq_AddToFingerprint4(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3);
 
 
 /*
@@ -111,6 +204,8 @@ Xcp_ReturnType XcpDaq_Free(void)
     XcpDaq_EntityCount = UINT16(0);
     XcpDaq_ListCount = UINT16(0);
     XcpDaq_OdtCount = UINT16(0);
+    XcpDaq_DropGatherPlan();
+    XcpDaq_QueueInit();
 
 #if XCP_DAQ_MULTIPLE_DAQ_LISTS_PER_EVENT_SUPPORTED  == XCP_OFF
     Xcp_MemSet(XcpDaq_ListForEvent, UINT8(0), UINT32(sizeof(XcpDaq_ListForEvent[0]) * UINT8(XCP_DAQ_MAX_EVENT_CHANNEL)));
@@ -119,6 +214,7 @@ Xcp_ReturnType XcpDaq_Free(void)
     if (XcpDaq_AllocValidateTransition(XCP_CALL_FREE_DAQ)) {
         Xcp_MemSet(XcpDaq_Entities, UINT8(0), UINT32(sizeof(XcpDaq_EntityType) * UINT16(NUM_DAQ_ENTITIES)));
         XcpDaq_AllocState = XCP_AFTER_FREE_DAQ;
+        XcpDaq_Fingerprint = XCP_DAQ_FNV_OFFSET_BASIS;
     } else {
         result = ERR_SEQUENCE;
     }
@@ -136,6 +232,8 @@ Xcp_ReturnType XcpDaq_Alloc(XcpDaq_ListIntegerType daqCount)
     } else {
         if ((XcpDaq_EntityCount + daqCount) <= UINT16(NUM_DAQ_ENTITIES)) {
             XcpDaq_AllocState = XCP_AFTER_ALLOC_DAQ;
+            XcpDaq_AddToFingerprint4(UINT8(XCP_ALLOC_DAQ), XCP_LOBYTE(daqCount), XCP_HIBYTE(daqCount), UINT8(0));
+            XcpDaq_InvalidateGatherPlan();
             for (idx = XcpDaq_EntityCount; idx < (XcpDaq_EntityCount + daqCount); ++idx) {
                 XcpDaq_Entities[idx].kind = UINT8(XCP_ENTITY_DAQ_LIST);
                 XcpDaq_Entities[idx].entity.daqList.numOdts = (XcpDaq_ODTIntegerType)0;
@@ -161,6 +259,8 @@ Xcp_ReturnType XcpDaq_AllocOdt(XcpDaq_ListIntegerType daqListNumber, XcpDaq_ODTI
     } else {
         if ((XcpDaq_EntityCount + odtCount) <= UINT16(NUM_DAQ_ENTITIES)) {
             XcpDaq_AllocState = XCP_AFTER_ALLOC_ODT;
+            XcpDaq_AddToFingerprint4(UINT8(XCP_ALLOC_ODT), XCP_LOBYTE(daqListNumber), XCP_HIBYTE(daqListNumber), UINT8(odtCount));
+            XcpDaq_InvalidateGatherPlan();
             for (idx = XcpDaq_EntityCount; idx < (XcpDaq_EntityCount + odtCount); ++idx) {
                 XcpDaq_Entities[idx].kind = UINT8(XCP_ENTITY_ODT);
             }
@@ -189,6 +289,8 @@ Xcp_ReturnType XcpDaq_AllocOdtEntry(XcpDaq_ListIntegerType daqListNumber, XcpDaq
     } else {
         if ((XcpDaq_EntityCount + odtEntriesCount) <= UINT16(NUM_DAQ_ENTITIES)) {
             XcpDaq_AllocState = XCP_AFTER_ALLOC_ODT_ENTRY;
+            XcpDaq_AddToFingerprint4(UINT8(XCP_ALLOC_ODT_ENTRY), UINT8(daqListNumber), UINT8(odtNumber), UINT8(odtEntriesCount));
+            XcpDaq_InvalidateGatherPlan();
             for (idx = XcpDaq_EntityCount; idx < (XcpDaq_EntityCount + odtEntriesCount); ++idx) {
                 XcpDaq_Entities[idx].kind = UINT8(XCP_ENTITY_ODT_ENTRY);
             }
@@ -207,6 +309,94 @@ Xcp_ReturnType XcpDaq_AllocOdtEntry(XcpDaq_ListIntegerType daqListNumber, XcpDaq
 void XcpDaq_Init(void)
 {
     XcpDaq_AllocState = XCP_ALLOC_IDLE;
+    XcpDaq_DropGatherPlan();
+    XcpDaq_QueueInit();
+}
+
+/*
+**  While the DAQ processor is running, the replacement plan is compiled right
+**  away, so started lists keep sampling; otherwise compilation is deferred to
+**  the next START.
+*/
+void XcpDaq_InvalidateGatherPlan(void)
+{
+    if (Xcp_GetState()->daqProcessor.state == XCP_DAQ_STATE_RUNNING) {
+        XcpDaq_CompileGatherPlan();
+    } else {
+        XcpDaq_DropGatherPlan();
+    }
+}
+
+/*
+**  The address mapping changed (mapper, page switching): cached plans hold
+**  host pointers resolved with the old mapping, so none of them is reused.
+*/
+void XcpDaq_FlushGatherPlans(void)
+{
+    uint8_t idx;
+
+    for (idx = UINT8(0); idx < UINT8(XCP_DAQ_PLAN_CACHE_SIZE); ++idx) {
+        XcpDaq_GatherPlanCache[idx].valid = (bool)XCP_FALSE;
+    }
+    XcpDaq_InvalidateGatherPlan();
+}
+
+/*
+**  The fingerprint is a FNV-1a hash over every configuration change since the
+**  last FREE_DAQ, so downloading the same configuration yields the same value.
+*/
+void XcpDaq_AddToFingerprint(uint8_t const * data, uint16_t length)
+{
+    uint16_t idx;
+
+    for (idx = UINT16(0); idx < length; ++idx) {
+        XcpDaq_Fingerprint ^= UINT32(data[idx]);
+        XcpDaq_Fingerprint *= XCP_DAQ_FNV_PRIME;
+    }
+}
+
+uint32_t XcpDaq_GetFingerprint(void)
+{
+    return XcpDaq_Fingerprint;
+}
+
+/*
+**  Activate the gather plan for the current configuration.
+**  The last XCP_DAQ_PLAN_CACHE_SIZE plans are kept; if one of them was compiled
+**  from the same configuration, compilation and validation are skipped altogether.
+**  Only slots that are neither active nor pinned by an event are rebuilt, so
+**  events see either the old or the new plan. Without such a slot the active
+**  plan is dropped and XcpDaq_MainFunction() retries.
+*/
+void XcpDaq_CompileGatherPlan(void)
+{
+    XcpDaq_GatherPlanType * plan;
+
+    XcpDaq_PlanUseCounter++;
+    plan = XcpDaq_FindCachedPlan();
+    if (plan == (XcpDaq_GatherPlanType *)XCP_NULL) {
+        XCP_DAQ_ENTER_CRITICAL();
+        plan = XcpDaq_FindFreeSlot();
+        if (plan == (XcpDaq_GatherPlanType *)XCP_NULL) {
+            XcpDaq_GatherPlan = (XcpDaq_GatherPlanType *)XCP_NULL;
+            plan = XcpDaq_FindFreeSlot();
+        }
+        if (plan != (XcpDaq_GatherPlanType *)XCP_NULL) {
+            plan->valid = (bool)XCP_FALSE;
+        }
+        XCP_DAQ_LEAVE_CRITICAL();
+        if (plan == (XcpDaq_GatherPlanType *)XCP_NULL) {
+            return;
+        }
+        XcpDaq_BuildGatherPlan(plan);
+        plan->fingerprint = XcpDaq_Fingerprint;
+        plan->valid = (bool)XCP_TRUE;
+    }
+    plan->lastUsed = XcpDaq_PlanUseCounter;
+
+    XCP_DAQ_ENTER_CRITICAL();
+    XcpDaq_GatherPlan = plan;
+    XCP_DAQ_LEAVE_CRITICAL();
 }
 
 XcpDaq_ODTEntryType * XcpDaq_GetOdtEntry(XcpDaq_ListIntegerType daqListNumber, XcpDaq_ODTIntegerType odtNumber, XcpDaq_ODTEntryIntegerType odtEntryNumber)
@@ -220,6 +410,21 @@ XcpDaq_ODTEntryType * XcpDaq_GetOdtEntry(XcpDaq_ListIntegerType daqListNumber, X
     return &XcpDaq_Entities[idx].entity.odtEntry;
 }
 
+/*
+**  ODTs are allocated back-to-back after the lists, so the absolute ODT number
+**  (== PID) is just the entity index minus the number of lists.
+*/
+uint8_t XcpDaq_GetFirstPid(XcpDaq_ListIntegerType daqListNumber)
+{
+    XcpDaq_ListType const * daqList;
+
+    daqList = XcpDaq_GetList(daqListNumber);
+    if (daqList->numOdts == (XcpDaq_ODTIntegerType)0) {
+        return UINT8(0);
+    }
+    return UINT8(daqList->firstOdt - XcpDaq_ListCount);
+}
+
 XcpDaq_ListType * XcpDaq_GetList(XcpDaq_ListIntegerType daqListNumber)
 {
     return &XcpDaq_Entities[daqListNumber].entity.daqList;
@@ -281,19 +486,59 @@ bool XcpDaq_ValidateOdtEntry(XcpDaq_ListIntegerType daqListNumber, XcpDaq_ODTInt
     return result;
 }
 
-void XcpDaq_MainFunction(void)
+/*
+**  Background transmitter: sends queued DTOs while the transport-layer is
+**  ready, until the byte or time budget is used up (at least one DTO per call
+**  if ready, so the queue always makes progress).
+**  Returns the number of DTOs still waiting.
+*/
+uint16_t XcpDaq_MainFunction(void)
 {
-    Xcp_StateType const * Xcp_State;
-    XcpDaq_ListIntegerType listCount;
+    uint16_t count;
+    uint16_t length;
+    bool ready;
+#if XCP_DAQ_MAIN_FUNCTION_BYTE_BUDGET > 0
+    uint32_t bytesSent = UINT32(0);
+#endif // XCP_DAQ_MAIN_FUNCTION_BYTE_BUDGET
+#if XCP_DAQ_MAIN_FUNCTION_TIME_BUDGET > 0
+    const uint32_t start = XcpHw_GetTimerCounter();
+#endif // XCP_DAQ_MAIN_FUNCTION_TIME_BUDGET
+
+    if ((XcpDaq_GatherPlan == (XcpDaq_GatherPlanType *)XCP_NULL) &&
+        (Xcp_GetState()->daqProcessor.state == XCP_DAQ_STATE_RUNNING)) {
+        XcpDaq_CompileGatherPlan();     /* Deferred, every slot was pinned. */
+    }
 
     XCP_DAQ_ENTER_CRITICAL();
-    Xcp_State = Xcp_GetState();
+    count = XcpDaq_Queue.count;
+    ready = XcpDaq_Queue.ready[XcpDaq_Queue.head];
     XCP_DAQ_LEAVE_CRITICAL();
 
-    if (Xcp_State->daqProcessor.state == XCP_DAQ_STATE_RUNNING) {
-        listCount = XcpDaq_GetDynamicListCount();   // // Check global state for DAQ/STIM running.
-        //printf("%u Active DAQ lists.\n", listCount);
+    while ((count > UINT16(0)) && ready && XcpTl_TxReady()) {
+        length = XcpDaq_Queue.length[XcpDaq_Queue.head];
+        Xcp_SendDto(XcpDaq_Queue.frame[XcpDaq_Queue.head], length);
+
+        XCP_DAQ_ENTER_CRITICAL();
+        XcpDaq_Queue.ready[XcpDaq_Queue.head] = (bool)XCP_FALSE;
+        XcpDaq_Queue.head = (XcpDaq_Queue.head + UINT16(1)) % UINT16(XCP_DAQ_QUEUE_SIZE);
+        XcpDaq_Queue.count--;
+        count = XcpDaq_Queue.count;
+        ready = XcpDaq_Queue.ready[XcpDaq_Queue.head];
+        XCP_DAQ_LEAVE_CRITICAL();
+
+#if XCP_DAQ_MAIN_FUNCTION_BYTE_BUDGET > 0
+        bytesSent += UINT32(length);
+        if (bytesSent >= UINT32(XCP_DAQ_MAIN_FUNCTION_BYTE_BUDGET)) {
+            break;
+        }
+#endif // XCP_DAQ_MAIN_FUNCTION_BYTE_BUDGET
+#if XCP_DAQ_MAIN_FUNCTION_TIME_BUDGET > 0
+        if ((XcpHw_GetTimerCounter() - start) >= UINT32(XCP_DAQ_MAIN_FUNCTION_TIME_BUDGET)) {
+            break;
+        }
+#endif // XCP_DAQ_MAIN_FUNCTION_TIME_BUDGET
     }
+    return count;
 }
 
 void XcpDaq_AddEventChannel(XcpDaq_ListIntegerType daqListNumber, uint16_t eventChannelNumber)
@@ -305,15 +550,40 @@ void XcpDaq_AddEventChannel(XcpDaq_ListIntegerType daqListNumber, uint16_t event
 
 void XcpDaq_TriggerEvent(uint8_t eventChannelNumber)
 {
-    XcpDaq_ListIntegerType daqList;
+    Xcp_StateType const * Xcp_State;
+    XcpDaq_ListIntegerType daqListNumber;
+    XcpDaq_ListType const * daqList;
+    XcpDaq_GatherPlanType * plan;
 
     if (eventChannelNumber > UINT8(XCP_DAQ_MAX_EVENT_CHANNEL - 1)) {
         return;
     }
+#if XCP_CAL_STAGING_SIZE > 0
+    XcpCal_TriggerEvent(eventChannelNumber);    /* Calibration changes take effect before sampling. */
+#endif // XCP_CAL_STAGING_SIZE
+    Xcp_State = Xcp_GetState();
+    if (Xcp_State->daqProcessor.state != XCP_DAQ_STATE_RUNNING) {
+        return;
+    }
 
 #if XCP_DAQ_MULTIPLE_DAQ_LISTS_PER_EVENT_SUPPORTED  == XCP_OFF
-    daqList = XcpDaq_ListForEvent[eventChannelNumber];
+    daqListNumber = XcpDaq_ListForEvent[eventChannelNumber];
 #endif // XCP_DAQ_MULTIPLE_DAQ_LISTS_PER_EVENT_SUPPORTED
+    if (daqListNumber >= XcpDaq_ListCount) {
+        return;
+    }
+    daqList = XcpDaq_GetList(daqListNumber);
+    if (((daqList->mode & XCP_DAQ_LIST_MODE_STARTED) == XCP_DAQ_LIST_MODE_STARTED) &&
+        ((daqList->mode & XCP_DAQ_LIST_MODE_DIRECTION) != XCP_DAQ_LIST_MODE_DIRECTION)) {
+        plan = XcpDaq_AcquireGatherPlan();
+        if (plan == (XcpDaq_GatherPlanType *)XCP_NULL) {
+            return;
+        }
+        if (daqListNumber < plan->numLists) {
+            XcpDaq_SampleList(plan, daqListNumber, daqList);
+        }
+        XcpDaq_ReleaseGatherPlan(plan);
+    }
 }
 
 
@@ -397,21 +667,109 @@ void XcpDaq_SetProcessorState(XcpDaq_ProcessorStateType state)
 }
 
 
-void XcpDaq_StartSelectedLists(void)
+Xcp_ReturnType XcpDaq_StartList(XcpDaq_ListIntegerType daqListNumber)
+{
+    Xcp_ReturnType result;
+    XcpDaq_ListType * entry;
+
+    result = XcpDaq_GetListStatus(daqListNumber);
+    if (result == ERR_SUCCESS) {
+        entry = XcpDaq_GetList(daqListNumber);
+        XCP_DAQ_ENTER_CRITICAL();
+        entry->mode |= XCP_DAQ_LIST_MODE_STARTED;
+        XCP_DAQ_LEAVE_CRITICAL();
+        XcpDaq_SetProcessorState(XCP_DAQ_STATE_RUNNING);
+    }
+    return result;
+}
+
+
+void XcpDaq_StopList(XcpDaq_ListIntegerType daqListNumber)
+{
+    XcpDaq_ListType * entry;
+
+    entry = XcpDaq_GetList(daqListNumber);
+    XCP_DAQ_ENTER_CRITICAL();
+    entry->mode &= UINT8(~XCP_DAQ_LIST_MODE_STARTED);
+    XCP_DAQ_LEAVE_CRITICAL();
+    if (!XcpDaq_AnyListStarted()) {
+        XcpDaq_SetProcessorState(XCP_DAQ_STATE_STOPPED);
+    }
+}
+
+/*
+**  CLEAR_DAQ_LIST: instead of resetting every ODT entry, the list epoch is
+**  bumped, which turns all entries written before into "unused" ones.
+**  Only on epoch wrap-around the entries of this list are really cleared.
+*/
+void XcpDaq_ClearList(XcpDaq_ListIntegerType daqListNumber)
+{
+    XcpDaq_ListType * daqList;
+    XcpDaq_ODTType const * odt;
+    XcpDaq_ODTIntegerType odtIdx;
+    XcpDaq_ODTEntryIntegerType entryIdx;
+
+    daqList = XcpDaq_GetList(daqListNumber);
+    XCP_DAQ_ENTER_CRITICAL();
+    daqList->mode &= UINT8(~(XCP_DAQ_LIST_MODE_STARTED | XCP_DAQ_LIST_MODE_SELECTED));
+    daqList->epoch++;
+    XCP_DAQ_LEAVE_CRITICAL();
+    if (!XcpDaq_AnyListStarted()) {
+        XcpDaq_SetProcessorState(XCP_DAQ_STATE_STOPPED);
+    }
+    XcpDaq_AddToFingerprint4(UINT8(XCP_CLEAR_DAQ_LIST), XCP_LOBYTE(daqListNumber), XCP_HIBYTE(daqListNumber), UINT8(0));
+    XcpDaq_InvalidateGatherPlan();
+
+    if (daqList->epoch == UINT8(0)) {
+        for (odtIdx = (XcpDaq_ODTIntegerType)0; odtIdx < daqList->numOdts; ++odtIdx) {
+            odt = XcpDaq_GetOdt(daqListNumber, odtIdx);
+            for (entryIdx = (XcpDaq_ODTEntryIntegerType)0; entryIdx < odt->numOdtEntries; ++entryIdx) {
+                Xcp_MemSet(XcpDaq_GetOdtEntry(daqListNumber, odtIdx, entryIdx), UINT8(0), UINT32(sizeof(XcpDaq_ODTEntryType)));
+            }
+        }
+    }
+}
+
+
+Xcp_ReturnType XcpDaq_StartSelectedLists(void)
 {
-    XcpDaq_StartStopLists(DAQ_LIST_TRANSITION_START);
+    Xcp_ReturnType result = ERR_SUCCESS;
+    XcpDaq_ListIntegerType idx;
+
+    for (idx = (XcpDaq_ListIntegerType)0; (idx < XcpDaq_ListCount) && (result == ERR_SUCCESS); ++idx) {
+        if ((XcpDaq_GetList(idx)->mode & XCP_DAQ_LIST_MODE_SELECTED) == XCP_DAQ_LIST_MODE_SELECTED) {
+            result = XcpDaq_GetListStatus(idx);
+        }
+    }
+    if (result == ERR_SUCCESS) {
+        XcpDaq_StartStopLists(DAQ_LIST_TRANSITION_START);
+    }
+    return result;
 }
 
 
 void XcpDaq_StopSelectedLists(void)
 {
     XcpDaq_StartStopLists(DAQ_LIST_TRANSITION_STOP);
+    if (!XcpDaq_AnyListStarted()) {
+        XcpDaq_SetProcessorState(XCP_DAQ_STATE_STOPPED);
+    }
 }
 
 
+/*
+**  STOP_ALL: every list, not only the selected ones (START_STOP_DAQ_LIST
+**  starts a list without selecting it).
+*/
 void XcpDaq_StopAllLists(void)
 {
-    XcpDaq_StartStopLists(DAQ_LIST_TRANSITION_STOP);
+    XcpDaq_ListIntegerType idx;
+
+    XCP_DAQ_ENTER_CRITICAL();
+    for (idx = (XcpDaq_ListIntegerType)0; idx < XcpDaq_ListCount; ++idx) {
+        XcpDaq_GetList(idx)->mode &= UINT8(~(XCP_DAQ_LIST_MODE_STARTED | XCP_DAQ_LIST_MODE_SELECTED));
+    }
+    XCP_DAQ_LEAVE_CRITICAL();
 }
 
 
@@ -449,10 +807,10 @@ static void XcpDaq_StartStopLists(XcpDaq_ListTransitionType transition)
         if ((entry->mode & XCP_DAQ_LIST_MODE_SELECTED) == XCP_DAQ_LIST_MODE_SELECTED) {
             if (transition == DAQ_LIST_TRANSITION_START) {
                 entry->mode |= XCP_DAQ_LIST_MODE_STARTED;
-                printf("Started DAQ list #%u\n", idx);
+                DBG_PRINT2("Started DAQ list #%u\n", idx);
             } else if (transition == DAQ_LIST_TRANSITION_STOP) {
                 entry->mode &= UINT8(~XCP_DAQ_LIST_MODE_STARTED);
-                printf("Stopped DAQ list #%u\n", idx);
+                DBG_PRINT2("Stopped DAQ list #%u\n", idx);
             } else {
                 /* Do nothing (to keep MISRA happy). */
             }
@@ -465,11 +823,399 @@ static void XcpDaq_StartStopLists(XcpDaq_ListTransitionType transition)
     }
 }
 
+static bool XcpDaq_AnyListStarted(void)
+{
+    XcpDaq_ListIntegerType idx;
+
+    for (idx = (XcpDaq_ListIntegerType)0; idx < XcpDaq_ListCount; ++idx) {
+        if ((XcpDaq_GetList(idx)->mode & XCP_DAQ_LIST_MODE_STARTED) == XCP_DAQ_LIST_MODE_STARTED) {
+            return (bool)XCP_TRUE;
+        }
+    }
+    return (bool)XCP_FALSE;
+}
+
 static XcpDaq_ListIntegerType XcpDaq_GetDynamicListCount(void)
 {
     return (XcpDaq_ListIntegerType)XcpDaq_ListCount;
 }
 
+/*
+**  Producer side of the DTO queue, may run in interrupt context.
+**  The slots are reserved (tail and count advanced) in one critical section,
+**  filled outside and committed in a second one, so concurrent events never
+**  share slots; a sample that doesn't fit completely is dropped.
+*/
+static void XcpDaq_SampleList(XcpDaq_GatherPlanType const * plan, XcpDaq_ListIntegerType daqListNumber, XcpDaq_ListType const * daqList)
+{
+    XcpDaq_GatherListType const * gatherList;
+    XcpDaq_GatherOdtType const * gatherOdt;
+    XcpDaq_GatherDescriptorType const * descriptor;
+    XcpDaq_ODTIntegerType odtIdx;
+    uint16_t idx;
+    uint16_t pos;
+    uint16_t first;
+    uint16_t slot;
+    uint8_t * frame;
+    uint32_t timestamp;
+
+    gatherList = &plan->lists[daqListNumber];
+
+    XCP_DAQ_ENTER_CRITICAL();
+    if ((UINT16(XCP_DAQ_QUEUE_SIZE) - XcpDaq_Queue.count) < UINT16(gatherList->numOdts)) {
+        XCP_DAQ_LEAVE_CRITICAL();
+        return;
+    }
+    first = XcpDaq_Queue.tail;
+    XcpDaq_Queue.tail = (XcpDaq_Queue.tail + UINT16(gatherList->numOdts)) % UINT16(XCP_DAQ_QUEUE_SIZE);
+    XcpDaq_Queue.count += UINT16(gatherList->numOdts);
+    XCP_DAQ_LEAVE_CRITICAL();
+
+    slot = first;
+
+    for (odtIdx = (XcpDaq_ODTIntegerType)0; odtIdx < gatherList->numOdts; ++odtIdx) {
+        gatherOdt = &plan->odts[gatherList->firstPid + odtIdx];
+        frame = XcpDaq_Queue.frame[slot];
+        pos = UINT16(4);
+        if ((daqList->mode & XCP_DAQ_LIST_MODE_PID_OFF) != XCP_DAQ_LIST_MODE_PID_OFF) {
+            frame[pos++] = UINT8(gatherList->firstPid + odtIdx);
+        }
+        if ((odtIdx == (XcpDaq_ODTIntegerType)0) && ((daqList->mode & XCP_DAQ_LIST_MODE_TIMESTAMP) == XCP_DAQ_LIST_MODE_TIMESTAMP)) {
+            timestamp = XcpHw_GetTimerCounter();
+            for (idx = UINT16(0); idx < UINT16(XCP_DAQ_TIMESTAMP_SIZE); ++idx) {
+                frame[pos++] = UINT8(timestamp & UINT32(0xff));
+                timestamp >>= 8;
+            }
+        }
+        for (idx = UINT16(0); idx < gatherOdt->numDescriptors; ++idx) {
+            descriptor = &plan->descriptors[gatherOdt->firstDescriptor + idx];
+            Xcp_MemTransfer(frame + pos, descriptor->address, UINT32(descriptor->length), descriptor->device);
+            pos += descriptor->length;
+        }
+        XcpDaq_Queue.length[slot] = pos - UINT16(4);
+        slot = (slot + UINT16(1)) % UINT16(XCP_DAQ_QUEUE_SIZE);
+    }
+
+    XCP_DAQ_ENTER_CRITICAL();
+    for (odtIdx = (XcpDaq_ODTIntegerType)0; odtIdx < gatherList->numOdts; ++odtIdx) {
+        XcpDaq_Queue.ready[(first + UINT16(odtIdx)) % UINT16(XCP_DAQ_QUEUE_SIZE)] = (bool)XCP_TRUE;
+    }
+    XCP_DAQ_LEAVE_CRITICAL();
+}
+
+/*
+**  Translate the DAQ configuration into a gather plan:
+**      - every ODT entry is range- and access-checked exactly once,
+**      - every ODT must fit into a DTO (PID, timestamp and payload),
+**      - empty entries are dropped.
+*/
+static void XcpDaq_BuildGatherPlan(XcpDaq_GatherPlanType * plan)
+{
+    XcpDaq_ListIntegerType listIdx;
+    XcpDaq_ODTIntegerType odtIdx;
+    uint16_t numDescriptors = UINT16(0);
+    uint16_t firstDescriptor;
+    uint16_t idx;
+
+    plan->numPids = XcpDaq_OdtCount;
+    plan->numLists = XcpDaq_ListCount;
+    plan->numEntities = XcpDaq_EntityCount;
+    for (idx = UINT16(0); idx < XcpDaq_EntityCount; ++idx) {
+        XcpDaq_GetGatherKey(idx, &plan->keys[idx]);
+    }
+    for (listIdx = (XcpDaq_ListIntegerType)0; listIdx < XcpDaq_ListCount; ++listIdx) {
+        firstDescriptor = numDescriptors;
+        plan->lists[listIdx].status = XcpDaq_BuildGatherList(plan, listIdx, &numDescriptors);
+        if (plan->lists[listIdx].status != ERR_SUCCESS) {
+            /* Drop the list, its descriptor slots are reused. */
+            for (odtIdx = (XcpDaq_ODTIntegerType)0; odtIdx < XcpDaq_GetList(listIdx)->numOdts; ++odtIdx) {
+                plan->odts[plan->lists[listIdx].firstPid + odtIdx].numDescriptors = UINT16(0);
+            }
+            plan->lists[listIdx].numOdts = (XcpDaq_ODTIntegerType)0;
+            numDescriptors = firstDescriptor;
+        }
+    }
+}
+
+static Xcp_ReturnType XcpDaq_BuildGatherList(XcpDaq_GatherPlanType * plan, XcpDaq_ListIntegerType listIdx, uint16_t * numDescriptors)
+{
+    XcpDaq_ODTIntegerType odtIdx;
+    XcpDaq_ODTEntryIntegerType entryIdx;
+    XcpDaq_ListType const * daqList;
+    XcpDaq_ODTType const * odt;
+    XcpDaq_ODTEntryType const * entry;
+    XcpDaq_GatherOdtType * gatherOdt;
+    XcpDaq_GatherDescriptorType * descriptor;
+    Xcp_MtaType mta;
+    Xcp_MemoryAccessType access;
+    uint8_t pid;
+    uint16_t dtoLength;
+
+    daqList = XcpDaq_GetList(listIdx);
+    access = ((daqList->mode & XCP_DAQ_LIST_MODE_DIRECTION) == XCP_DAQ_LIST_MODE_DIRECTION) ? XCP_MEM_ACCESS_WRITE : XCP_MEM_ACCESS_READ;
+    plan->lists[listIdx].firstPid = XcpDaq_GetFirstPid(listIdx);
+    plan->lists[listIdx].numOdts = daqList->numOdts;
+    for (odtIdx = (XcpDaq_ODTIntegerType)0; odtIdx < daqList->numOdts; ++odtIdx) {
+        odt = XcpDaq_GetOdt(listIdx, odtIdx);
+        pid = UINT8(plan->lists[listIdx].firstPid + odtIdx);
+        plan->pids[pid].daqList = listIdx;
+        plan->pids[pid].odt = odtIdx;
+        gatherOdt = &plan->odts[pid];
+        gatherOdt->firstDescriptor = *numDescriptors;
+        gatherOdt->numDescriptors = UINT16(0);
+        dtoLength = UINT16(0);
+        if ((daqList->mode & XCP_DAQ_LIST_MODE_PID_OFF) != XCP_DAQ_LIST_MODE_PID_OFF) {
+            dtoLength += UINT16(1);
+        }
+        if ((odtIdx == (XcpDaq_ODTIntegerType)0) && ((daqList->mode & XCP_DAQ_LIST_MODE_TIMESTAMP) == XCP_DAQ_LIST_MODE_TIMESTAMP)) {
+            dtoLength += UINT16(XCP_DAQ_TIMESTAMP_SIZE);
+        }
+        for (entryIdx = (XcpDaq_ODTEntryIntegerType)0; entryIdx < odt->numOdtEntries; ++entryIdx) {
+            entry = XcpDaq_GetOdtEntry(listIdx, odtIdx, entryIdx);
+            if ((entry->length == UINT32(0)) || (entry->epoch != daqList->epoch)) {
+                continue;   /* Unused or cleared. */
+            }
+            if (entry->length > UINT32(XCP_MAX_DTO)) {
+                return ERR_DAQ_CONFIG;
+            }
+            dtoLength += UINT16(entry->length);
+            if (dtoLength > UINT16(XCP_MAX_DTO)) {
+                return ERR_DAQ_CONFIG;
+            }
+            mta.address = entry->mta.address;
+#if XCP_DAQ_ADDR_EXT_SUPPORTED == XCP_ON
+            mta.ext = entry->mta.ext;
+#else
+            mta.ext = UINT8(0);
+#endif // XCP_DAQ_ADDR_EXT_SUPPORTED
+            if (!Xcp_CheckMemoryAccess(mta, entry->length, access, (bool)XCP_FALSE)) {
+                return ERR_ACCESS_DENIED;
+            }
+            descriptor = &plan->descriptors[*numDescriptors];
+            descriptor->address = Xcp_MapAddress(mta, entry->length);
+            if (descriptor->address == (uint8_t *)XCP_NULL) {
+                return ERR_ACCESS_DENIED;
+            }
+            descriptor->length = UINT16(entry->length);
+            descriptor->device = Xcp_IsDeviceMemory(mta);
+            gatherOdt->numDescriptors++;
+            (*numDescriptors)++;
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+static void XcpDaq_DropGatherPlan(void)
+{
+    XCP_DAQ_ENTER_CRITICAL();
+    XcpDaq_GatherPlan = (XcpDaq_GatherPlanType *)XCP_NULL;
+    XCP_DAQ_LEAVE_CRITICAL();
+}
+
+static XcpDaq_GatherPlanType * XcpDaq_FindCachedPlan(void)
+{
+    XcpDaq_GatherPlanType * slot;
+    uint8_t idx;
+
+    for (idx = UINT8(0); idx < UINT8(XCP_DAQ_PLAN_CACHE_SIZE); ++idx) {
+        slot = &XcpDaq_GatherPlanCache[idx];
+        if ((slot->valid) && (slot->fingerprint == XcpDaq_Fingerprint) && XcpDaq_PlanMatches(slot)) {
+            return slot;
+        }
+    }
+    return (XcpDaq_GatherPlanType *)XCP_NULL;
+}
+
+/*
+**  Least recently used slot that may be rebuilt, call with XCP_DAQ_ENTER_CRITICAL():
+**  once a slot is inactive, no event can pin it anymore.
+*/
+static XcpDaq_GatherPlanType * XcpDaq_FindFreeSlot(void)
+{
+    XcpDaq_GatherPlanType * plan = (XcpDaq_GatherPlanType *)XCP_NULL;
+    XcpDaq_GatherPlanType * slot;
+    uint8_t idx;
+
+    for (idx = UINT8(0); idx < UINT8(XCP_DAQ_PLAN_CACHE_SIZE); ++idx) {
+        slot = &XcpDaq_GatherPlanCache[idx];
+        if ((slot == XcpDaq_GatherPlan) || (slot->users != UINT8(0))) {
+            continue;
+        }
+        if ((plan == (XcpDaq_GatherPlanType *)XCP_NULL) || (!slot->valid) ||
+            (plan->valid && (slot->lastUsed < plan->lastUsed))) {
+            plan = slot;
+        }
+    }
+    return plan;
+}
+
+static void XcpDaq_GetGatherKey(uint16_t idx, XcpDaq_GatherKeyType * key)
+{
+    XcpDaq_EntityType const * entity = &XcpDaq_Entities[idx];
+
+    Xcp_MemSet(key, UINT8(0), UINT32(sizeof(XcpDaq_GatherKeyType)));
+    key->kind = entity->kind;
+    if (entity->kind == UINT8(XCP_ENTITY_DAQ_LIST)) {
+        key->address = UINT32(entity->entity.daqList.firstOdt);
+        key->length = UINT32(entity->entity.daqList.numOdts);
+        key->mode = entity->entity.daqList.mode & UINT8(XCP_DAQ_LIST_MODE_DIRECTION | XCP_DAQ_LIST_MODE_TIMESTAMP | XCP_DAQ_LIST_MODE_PID_OFF);
+        key->epoch = entity->entity.daqList.epoch;
+    } else if (entity->kind == UINT8(XCP_ENTITY_ODT)) {
+        key->address = UINT32(entity->entity.odt.firstOdtEntry);
+        key->length = UINT32(entity->entity.odt.numOdtEntries);
+    } else if (entity->kind == UINT8(XCP_ENTITY_ODT_ENTRY)) {
+        key->address = entity->entity.odtEntry.mta.address;
+#if XCP_DAQ_ADDR_EXT_SUPPORTED == XCP_ON
+        key->ext = entity->entity.odtEntry.mta.ext;
+#endif // XCP_DAQ_ADDR_EXT_SUPPORTED
+        key->length = entity->entity.odtEntry.length;
+        key->epoch = entity->entity.odtEntry.epoch;
+    } else {
+        /* Do nothing (to keep MISRA happy). */
+    }
+}
+
+/*
+**  The fingerprint alone may collide: a cached plan is only reused if it was
+**  compiled from exactly the current configuration.
+*/
+static bool XcpDaq_PlanMatches(XcpDaq_GatherPlanType const * plan)
+{
+    XcpDaq_GatherKeyType key;
+    XcpDaq_GatherKeyType const * cached;
+    uint16_t idx;
+
+    if (plan->numEntities != XcpDaq_EntityCount) {
+        return (bool)XCP_FALSE;
+    }
+    for (idx = UINT16(0); idx < XcpDaq_EntityCount; ++idx) {
+        XcpDaq_GetGatherKey(idx, &key);
+        cached = &plan->keys[idx];
+        if ((key.kind != cached->kind) || (key.address != cached->address) || (key.length != cached->length) ||
+            (key.ext != cached->ext) || (key.mode != cached->mode) || (key.epoch != cached->epoch)) {
+            return (bool)XCP_FALSE;
+        }
+    }
+    return (bool)XCP_TRUE;
+}
+
+/*
+**  Event side: the active plan is read once and pinned while it's sampled,
+**  so the command context doesn't rebuild it underneath.
+*/
+static XcpDaq_GatherPlanType * XcpDaq_AcquireGatherPlan(void)
+{
+    XcpDaq_GatherPlanType * plan;
+
+    XCP_DAQ_ENTER_CRITICAL();
+    plan = XcpDaq_GatherPlan;
+    if (plan != (XcpDaq_GatherPlanType *)XCP_NULL) {
+        plan->users++;
+    }
+    XCP_DAQ_LEAVE_CRITICAL();
+    return plan;
+}
+
+static void XcpDaq_ReleaseGatherPlan(XcpDaq_GatherPlanType * plan)
+{
+    XCP_DAQ_ENTER_CRITICAL();
+    plan->users--;
+    XCP_DAQ_LEAVE_CRITICAL();
+}
+
+/*
+**  Result of validating a list, compiles the plan if there is none.
+*/
+static Xcp_ReturnType XcpDaq_GetListStatus(XcpDaq_ListIntegerType daqListNumber)
+{
+    if (XcpDaq_GatherPlan == (XcpDaq_GatherPlanType *)XCP_NULL) {
+        XcpDaq_CompileGatherPlan();
+    }
+    if (XcpDaq_GatherPlan == (XcpDaq_GatherPlanType *)XCP_NULL) {
+        return ERR_CMD_BUSY;    /* Every slot still pinned by an event. */
+    }
+    return XcpDaq_GatherPlan->lists[daqListNumber].status;
+}
+
+#if XCP_ENABLE_STIM == XCP_ON
+/*
+**  STIM DTO from the master: the PID selects the ODT directly, the data is
+**  scattered over the (write-checked) descriptors of the gather plan. It is
+**  dropped while a BUILD_CHECKSUM is calculated in the background.
+*/
+void XcpDaq_StimReceive(Xcp_PDUType const * const pdu)
+{
+    XcpDaq_GatherPidType const * gatherPid;
+    XcpDaq_GatherOdtType const * gatherOdt;
+    XcpDaq_GatherDescriptorType const * descriptor;
+    XcpDaq_ListType const * daqList;
+    XcpDaq_GatherPlanType * plan;
+    const uint8_t pid = pdu->data[0];
+    uint16_t pos = UINT16(1);
+    uint16_t idx;
+
+#if (XCP_ENABLE_BUILD_CHECKSUM == XCP_ON) && (XCP_CHECKSUM_CHUNKED_CALCULATION == XCP_ON)
+    if (Xcp_ChecksumIsPending()) {
+        return;
+    }
+#endif // XCP_CHECKSUM_CHUNKED_CALCULATION
+    plan = XcpDaq_AcquireGatherPlan();
+    if (plan == (XcpDaq_GatherPlanType *)XCP_NULL) {
+        return;
+    }
+    if (UINT16(pid) >= plan->numPids) {
+        XcpDaq_ReleaseGatherPlan(plan);
+        return;
+    }
+    gatherPid = &plan->pids[pid];
+    daqList = XcpDaq_GetList(gatherPid->daqList);
+    if (((daqList->mode & XCP_DAQ_LIST_MODE_STARTED) != XCP_DAQ_LIST_MODE_STARTED) ||
+        ((daqList->mode & XCP_DAQ_LIST_MODE_DIRECTION) != XCP_DAQ_LIST_MODE_DIRECTION)) {
+        XcpDaq_ReleaseGatherPlan(plan);
+        return;
+    }
+    if ((gatherPid->odt == (XcpDaq_ODTIntegerType)0) && ((daqList->mode & XCP_DAQ_LIST_MODE_TIMESTAMP) == XCP_DAQ_LIST_MODE_TIMESTAMP)) {
+        pos += UINT16(XCP_DAQ_TIMESTAMP_SIZE);
+    }
+    gatherOdt = &plan->odts[pid];
+    XCP_STIM_ENTER_CRITICAL();
+    for (idx = UINT16(0); idx < gatherOdt->numDescriptors; ++idx) {
+        descriptor = &plan->descriptors[gatherOdt->firstDescriptor + idx];
+        if ((pos + descriptor->length) > pdu->len) {
+            break;
+        }
+        Xcp_MemTransfer(descriptor->address, pdu->data + pos, UINT32(descriptor->length), descriptor->device);
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+        Xcp_ChecksumMarkDirty(descriptor->address, UINT32(descriptor->length));
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+        pos += descriptor->length;
+    }
+    XCP_STIM_LEAVE_CRITICAL();
+    XcpDaq_ReleaseGatherPlan(plan);
+}
+#endif // XCP_ENABLE_STIM
+
+static void XcpDaq_AddToFingerprint4(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3)
+{
+    uint8_t data[4];
+
+    data[0] = b0;
+    data[1] = b1;
+    data[2] = b2;
+    data[3] = b3;
+    XcpDaq_AddToFingerprint(data, UINT16(4));
+}
+
+static void XcpDaq_QueueInit(void)
+{
+    XCP_DAQ_ENTER_CRITICAL();
+    XcpDaq_Queue.head = UINT16(0);
+    XcpDaq_Queue.tail = UINT16(0);
+    XcpDaq_Queue.count = UINT16(0);
+    Xcp_MemSet(XcpDaq_Queue.ready, UINT8(0), UINT32(sizeof(XcpDaq_Queue.ready)));
+    XCP_DAQ_LEAVE_CRITICAL();
+}
+
 #if 0
 1.1.1.3  OBJECT DESCRIPTION TABLE (ODT)
 
@@ -0,0 +1,324 @@
+/*
+ * BlueParrot XCP
+ *
+ * (C) 2007-2019 by Christoph Schueler <github.com/Christoph2,
+ *                                      cpu12.gems@googlemail.com>
+ *
+ * All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * s. FLOSS-EXCEPTION.txt
+ */
+
+#include "xcp.h"
+#include "xcp_util.h"
+
+#if XCP_ENABLE_PAG_COMMANDS == XCP_ON
+
+#define XCP_PAG_ECU_ACCESS  (XCP_PAG_ECU_ACCESS_WITHOUT_XCP | XCP_PAG_ECU_ACCESS_WITH_XCP)
+#define XCP_PAG_XCP_READ    (XCP_PAG_XCP_READ_ACCESS_WITHOUT_ECU | XCP_PAG_XCP_READ_ACCESS_WITH_ECU)
+#define XCP_PAG_XCP_WRITE   (XCP_PAG_XCP_WRITE_ACCESS_WITHOUT_ECU | XCP_PAG_XCP_WRITE_ACCESS_WITH_ECU)
+
+
+/*
+** Local Variables.
+*/
+
+/*
+**  The application reads its calibration data through the published ECU page
+**  table. A page switch fills the idle table and publishes it with a single
+**  pointer store, so the control loop never sees a partially applied switch,
+**  not even for SET_CAL_PAGE(ALL).
+*/
+static uint8_t * XcpPag_EcuTables[2][XCP_PAG_SEGMENTS];
+static uint8_t * const * volatile XcpPag_EcuTable;
+
+static uint8_t XcpPag_EcuPage[XCP_PAG_SEGMENTS];
+static uint8_t XcpPag_XcpPage[XCP_PAG_SEGMENTS];
+static uint8_t XcpPag_SegmentMode[XCP_PAG_SEGMENTS];
+
+
+/*
+** Local Function Prototypes.
+*/
+static Xcp_ReturnType XcpPag_CheckPage(uint8_t segment, uint8_t page, uint8_t mode);
+static void XcpPag_PublishEcuPages(uint8_t first, uint8_t last, uint8_t page);
+#if XCP_ENABLE_COPY_CAL_PAGE_HOOK == XCP_ON
+static void XcpPag_MovePage(uint8_t segment, uint8_t page, uint8_t * data);
+#endif // XCP_ENABLE_COPY_CAL_PAGE_HOOK
+
+
+/*
+** Global Functions.
+*/
+void XcpPag_Init(void)
+{
+    uint8_t idx;
+
+    XCP_PAG_ENTER_CRITICAL();
+    for (idx = UINT8(0); idx < UINT8(XCP_PAG_SEGMENTS); ++idx) {
+        XcpPag_EcuPage[idx] = UINT8(0);
+        XcpPag_XcpPage[idx] = UINT8(0);
+        XcpPag_SegmentMode[idx] = UINT8(0);
+        XcpPag_EcuTables[0][idx] = Xcp_PagSegments[idx].pages[0].data;
+        XcpPag_EcuTables[1][idx] = Xcp_PagSegments[idx].pages[0].data;
+    }
+    XcpPag_EcuTable = XcpPag_EcuTables[0];
+    XCP_PAG_LEAVE_CRITICAL();
+}
+
+/**
+ * Select the active page of one (or with XCP_PAG_MODE_ALL every) segment for
+ * the ECU and/or XCP.
+ */
+Xcp_ReturnType XcpPag_SetCalPage(uint8_t segment, uint8_t page, uint8_t mode)
+{
+    uint8_t first = segment;
+    uint8_t last = segment;
+    uint8_t idx;
+    Xcp_ReturnType result;
+
+    if (((mode & UINT8(~(XCP_PAG_MODE_ECU | XCP_PAG_MODE_XCP | XCP_PAG_MODE_ALL))) != UINT8(0)) ||
+        ((mode & (XCP_PAG_MODE_ECU | XCP_PAG_MODE_XCP)) == UINT8(0))) {
+        return ERR_MODE_NOT_VALID;
+    }
+    if ((mode & XCP_PAG_MODE_ALL) == XCP_PAG_MODE_ALL) {
+        first = UINT8(0);
+        last = UINT8(XCP_PAG_SEGMENTS - 1);
+    }
+    for (idx = first; idx <= last; ++idx) {
+        result = XcpPag_CheckPage(idx, page, mode);
+        if (result != ERR_SUCCESS) {
+            return result;
+        }
+    }
+#if XCP_CAL_STAGING_SIZE > 0
+    if (((mode & XCP_PAG_MODE_XCP) == XCP_PAG_MODE_XCP) && XcpCal_IsPending()) {
+        return ERR_SEQUENCE;
+    }
+#endif // XCP_CAL_STAGING_SIZE
+    XCP_PAG_ENTER_CRITICAL();
+    if ((mode & XCP_PAG_MODE_ECU) == XCP_PAG_MODE_ECU) {
+        for (idx = first; idx <= last; ++idx) {
+            XcpPag_EcuPage[idx] = page;
+        }
+        XcpPag_PublishEcuPages(first, last, page);
+    }
+    if ((mode & XCP_PAG_MODE_XCP) == XCP_PAG_MODE_XCP) {
+        for (idx = first; idx <= last; ++idx) {
+            XcpPag_XcpPage[idx] = page;
+        }
+    }
+    XCP_PAG_LEAVE_CRITICAL();
+#if XCP_ENABLE_DAQ_COMMANDS == XCP_ON
+    if ((mode & XCP_PAG_MODE_XCP) == XCP_PAG_MODE_XCP) {
+        XcpDaq_FlushGatherPlans();  /* Entries may now resolve to another page. */
+    }
+#endif // XCP_ENABLE_DAQ_COMMANDS
+    return ERR_SUCCESS;
+}
+
+Xcp_ReturnType XcpPag_GetCalPage(uint8_t segment, uint8_t mode, uint8_t * page)
+{
+    if (segment >= UINT8(XCP_PAG_SEGMENTS)) {
+        return ERR_SEGMENT_NOT_VALID;
+    }
+    if (mode == XCP_PAG_MODE_ECU) {
+        *page = XcpPag_EcuPage[segment];
+    } else if (mode == XCP_PAG_MODE_XCP) {
+        *page = XcpPag_XcpPage[segment];
+    } else {
+        return ERR_MODE_NOT_VALID;
+    }
+    return ERR_SUCCESS;
+}
+
+Xcp_ReturnType XcpPag_SetSegmentMode(uint8_t segment, uint8_t mode)
+{
+    if (segment >= UINT8(XCP_PAG_SEGMENTS)) {
+        return ERR_SEGMENT_NOT_VALID;
+    }
+    if ((mode & UINT8(~XCP_PAG_SEGMENT_MODE_FREEZE)) != UINT8(0)) {
+        return ERR_MODE_NOT_VALID;
+    }
+    XcpPag_SegmentMode[segment] = mode;
+    return ERR_SUCCESS;
+}
+
+Xcp_ReturnType XcpPag_GetSegmentMode(uint8_t segment, uint8_t * mode)
+{
+    if (segment >= UINT8(XCP_PAG_SEGMENTS)) {
+        return ERR_SEGMENT_NOT_VALID;
+    }
+    *mode = XcpPag_SegmentMode[segment];
+    return ERR_SUCCESS;
+}
+
+Xcp_ReturnType XcpPag_CopyCalPage(uint8_t srcSegment, uint8_t srcPage, uint8_t dstSegment, uint8_t dstPage)
+{
+    Xcp_PagSegmentType const * src;
+    Xcp_PagSegmentType const * dst;
+#if XCP_ENABLE_COPY_CAL_PAGE_HOOK == XCP_ON
+    uint8_t * data;
+#endif // XCP_ENABLE_COPY_CAL_PAGE_HOOK
+
+    if ((srcSegment >= UINT8(XCP_PAG_SEGMENTS)) || (dstSegment >= UINT8(XCP_PAG_SEGMENTS))) {
+        return ERR_SEGMENT_NOT_VALID;
+    }
+    src = &Xcp_PagSegments[srcSegment];
+    dst = &Xcp_PagSegments[dstSegment];
+    if ((srcPage >= src->pageCount) || (dstPage >= dst->pageCount)) {
+        return ERR_PAGE_NOT_VALID;
+    }
+    if (src->length != dst->length) {
+        return ERR_SEGMENT_NOT_VALID;
+    }
+    if ((dst->pages[dstPage].properties & XCP_PAG_XCP_WRITE) == UINT8(0)) {
+        return ERR_WRITE_PROTECTED;
+    }
+    if ((srcSegment == dstSegment) && (srcPage == dstPage)) {
+        return ERR_SUCCESS;
+    }
+#if XCP_ENABLE_COPY_CAL_PAGE_HOOK == XCP_ON
+#if XCP_CAL_STAGING_SIZE > 0
+    if (XcpCal_IsPending()) {
+        return ERR_SEQUENCE;    /* The hook may move a page staged writes point into. */
+    }
+#endif // XCP_CAL_STAGING_SIZE
+    /* E.g. a copy-on-write mapping of the source, s. FlsEmu_CopyOnWrite(). */
+    data = dst->pages[dstPage].data;
+    if (Xcp_HookFunction_CopyCalPage(srcSegment, srcPage, dstSegment, dstPage, &data)) {
+        if (data == (uint8_t *)XCP_NULL) {
+            return ERR_GENERIC;
+        }
+        XcpPag_MovePage(dstSegment, dstPage, data);
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+        Xcp_ChecksumMarkDirty(data, dst->length);
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+        return ERR_SUCCESS;
+    }
+#endif // XCP_ENABLE_COPY_CAL_PAGE_HOOK
+    Xcp_MemCopy(dst->pages[dstPage].data, src->pages[srcPage].data, dst->length);
+#if XCP_CHECKSUM_INDEX_REGIONS > 0
+    Xcp_ChecksumMarkDirty(dst->pages[dstPage].data, dst->length);
+#endif // XCP_CHECKSUM_INDEX_REGIONS
+    return ERR_SUCCESS;
+}
+
+/**
+ * Host memory of the page the application currently works on.
+ *
+ * To read several segments consistently, take one snapshot with
+ * XcpPag_GetEcuPageTable() per cycle instead.
+ */
+uint8_t * XcpPag_GetEcuPage(uint8_t segment)
+{
+    return XcpPag_EcuTable[segment];
+}
+
+/**
+ * Snapshot of the ECU page of every segment, indexed by segment number.
+ *
+ * The snapshot is not modified by the next page switch; it stays valid until
+ * the switch after that.
+ */
+uint8_t * const * XcpPag_GetEcuPageTable(void)
+{
+    return XcpPag_EcuTable;
+}
+
+/**
+ * Resolve an XCP access to the page XCP currently works on.
+ *
+ * @return XCP_NULL if `mta`/`length` is not contained in a segment.
+ */
+uint8_t * XcpPag_MapAddress(Xcp_MtaType mta, uint32_t length)
+{
+    Xcp_PagSegmentType const * segment;
+    uint8_t idx;
+
+    for (idx = UINT8(0); idx < UINT8(XCP_PAG_SEGMENTS); ++idx) {
+        segment = &Xcp_PagSegments[idx];
+        if ((mta.ext == segment->ext) && (mta.address >= segment->address) &&
+            ((mta.address - segment->address) <= segment->length) &&
+            (length <= (segment->length - (mta.address - segment->address)))) {
+            return segment->pages[XcpPag_XcpPage[idx]].data + (mta.address - segment->address);
+        }
+    }
+    return (uint8_t *)XCP_NULL;
+}
+
+
+/*
+** Local Functions.
+*/
+static Xcp_ReturnType XcpPag_CheckPage(uint8_t segment, uint8_t page, uint8_t mode)
+{
+    uint8_t properties;
+
+    if (segment >= UINT8(XCP_PAG_SEGMENTS)) {
+        return ERR_SEGMENT_NOT_VALID;
+    }
+    if (page >= Xcp_PagSegments[segment].pageCount) {
+        return ERR_PAGE_NOT_VALID;
+    }
+    properties = Xcp_PagSegments[segment].pages[page].properties;
+    if ((((mode & XCP_PAG_MODE_ECU) == XCP_PAG_MODE_ECU) && ((properties & XCP_PAG_ECU_ACCESS) == UINT8(0))) ||
+        (((mode & XCP_PAG_MODE_XCP) == XCP_PAG_MODE_XCP) && ((properties & (XCP_PAG_XCP_READ | XCP_PAG_XCP_WRITE)) == UINT8(0)))) {
+        return ERR_MODE_NOT_VALID;
+    }
+    return ERR_SUCCESS;
+}
+
+/*
+**  Fill the idle ECU page table (`page` for segments [first, last], the
+**  others unchanged) and publish it. Called within XCP_PAG_ENTER_CRITICAL().
+*/
+static void XcpPag_PublishEcuPages(uint8_t first, uint8_t last, uint8_t page)
+{
+    uint8_t * const * current = XcpPag_EcuTable;
+    uint8_t ** next = (current == XcpPag_EcuTables[0]) ? XcpPag_EcuTables[1] : XcpPag_EcuTables[0];
+    uint8_t idx;
+
+    for (idx = UINT8(0); idx < UINT8(XCP_PAG_SEGMENTS); ++idx) {
+        next[idx] = ((idx >= first) && (idx <= last)) ? Xcp_PagSegments[idx].pages[page].data : current[idx];
+    }
+    XcpPag_EcuTable = next;    /* The switch: a single pointer store. */
+}
+
+#if XCP_ENABLE_COPY_CAL_PAGE_HOOK == XCP_ON
+/*
+**  The page now lives at `data`; if the ECU works on it, the ECU page table is
+**  republished like on SET_CAL_PAGE. The old memory is still referenced by
+**  the previous table, so the hook must not release it before its next call.
+*/
+static void XcpPag_MovePage(uint8_t segment, uint8_t page, uint8_t * data)
+{
+    XCP_PAG_ENTER_CRITICAL();
+    Xcp_PagSegments[segment].pages[page].data = data;
+    if (XcpPag_EcuPage[segment] == page) {
+        XcpPag_PublishEcuPages(segment, segment, page);
+    }
+    XCP_PAG_LEAVE_CRITICAL();
+#if XCP_ENABLE_DAQ_COMMANDS == XCP_ON
+    if (XcpPag_XcpPage[segment] == page) {
+        XcpDaq_FlushGatherPlans();
+    }
+#endif // XCP_ENABLE_DAQ_COMMANDS
+}
+#endif // XCP_ENABLE_COPY_CAL_PAGE_HOOK
+
+#endif // XCP_ENABLE_PAG_COMMANDS
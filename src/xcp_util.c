@@ -31,15 +31,105 @@
 #include <stdio.h>
 #endif // _MSC_VER
 
+/*
+**  Bulk transfers: bytes up to an aligned destination, then 16 byte vectors
+**  (SSE2 / NEON) resp. machine words, then the remaining bytes. Short blocks,
+**  the common case for SHORT_UPLOAD and DAQ entries, are done bytewise.
+**  The intrinsics headers need the <stdint.h> types (s. xcp_types.h).
+*/
+#if !defined(XCP_HAS_STDINT_H)
+    /* Machine words only. */
+#elif ((defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)) || (defined(_MSC_VER) && defined(_M_X64))
+    #define XCP_MEM_SSE2
+    #include <emmintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    #define XCP_MEM_NEON
+    #include <arm_neon.h>
+#endif
+
+#if defined(XCP_MEM_SSE2) || defined(XCP_MEM_NEON)
+#define XCP_MEM_VECTOR_SIZE     UINT32(16)
+#define XCP_MEM_ALIGNMENT       XCP_MEM_VECTOR_SIZE
+#else
+#if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__)
+typedef uint64_t Xcp_MemWordValueType;
+#else
+typedef uint32_t Xcp_MemWordValueType;
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+typedef Xcp_MemWordValueType __attribute__((__may_alias__)) Xcp_MemWordType;
+#else
+typedef Xcp_MemWordValueType Xcp_MemWordType;
+#endif
+#define XCP_MEM_WORD_SIZE       UINT32(sizeof(Xcp_MemWordType))
+#define XCP_MEM_ALIGNMENT       XCP_MEM_WORD_SIZE
+#endif // XCP_MEM_SSE2 || XCP_MEM_NEON
+
+#define XCP_MEM_BULK_THRESHOLD  UINT32(32)
+#define XCP_MEM_MISALIGNMENT(ptr)   (UINT32((uintptr_t)(ptr)) & (XCP_MEM_ALIGNMENT - UINT32(1)))
+
 void Xcp_MemCopy(void * dst, void * src, uint32_t len)
 {
     uint8_t * pd = (uint8_t *)dst;
-    uint8_t * ps = (uint8_t *)src;
+    uint8_t const * ps = (uint8_t const *)src;
 
 //    ASSERT(dst != (void *)NULL);
 //    ASSERT(pd >= ps + len || ps >= pd + len);
 //    ASSERT(len != (uint16_t)0);
 
+    if (len >= XCP_MEM_BULK_THRESHOLD) {
+        while (XCP_MEM_MISALIGNMENT(pd) != UINT32(0)) {
+            *pd++ = *ps++;
+            --len;
+        }
+#if defined(XCP_MEM_SSE2)
+        while (len >= UINT32(4) * XCP_MEM_VECTOR_SIZE) {
+            __m128i const v0 = _mm_loadu_si128((__m128i const *)ps);
+            __m128i const v1 = _mm_loadu_si128((__m128i const *)(ps + 16));
+            __m128i const v2 = _mm_loadu_si128((__m128i const *)(ps + 32));
+            __m128i const v3 = _mm_loadu_si128((__m128i const *)(ps + 48));
+
+            _mm_store_si128((__m128i *)pd, v0);
+            _mm_store_si128((__m128i *)(pd + 16), v1);
+            _mm_store_si128((__m128i *)(pd + 32), v2);
+            _mm_store_si128((__m128i *)(pd + 48), v3);
+            pd += 64;
+            ps += 64;
+            len -= UINT32(64);
+        }
+        while (len >= XCP_MEM_VECTOR_SIZE) {
+            _mm_store_si128((__m128i *)pd, _mm_loadu_si128((__m128i const *)ps));
+            pd += XCP_MEM_VECTOR_SIZE;
+            ps += XCP_MEM_VECTOR_SIZE;
+            len -= XCP_MEM_VECTOR_SIZE;
+        }
+#elif defined(XCP_MEM_NEON)
+        while (len >= UINT32(4) * XCP_MEM_VECTOR_SIZE) {
+            uint8x16x4_t const v = vld1q_u8_x4(ps);
+
+            vst1q_u8_x4(pd, v);
+            pd += 64;
+            ps += 64;
+            len -= UINT32(64);
+        }
+        while (len >= XCP_MEM_VECTOR_SIZE) {
+            vst1q_u8(pd, vld1q_u8(ps));
+            pd += XCP_MEM_VECTOR_SIZE;
+            ps += XCP_MEM_VECTOR_SIZE;
+            len -= XCP_MEM_VECTOR_SIZE;
+        }
+#else
+        /* Word accesses only if the source is aligned as well. */
+        if (XCP_MEM_MISALIGNMENT(ps) == UINT32(0)) {
+            while (len >= XCP_MEM_WORD_SIZE) {
+                *(Xcp_MemWordType *)pd = *(Xcp_MemWordType const *)ps;
+                pd += XCP_MEM_WORD_SIZE;
+                ps += XCP_MEM_WORD_SIZE;
+                len -= XCP_MEM_WORD_SIZE;
+            }
+        }
+#endif // XCP_MEM_SSE2
+    }
     while (len--) {
         *pd++ = *ps++;
     }
@@ -52,6 +142,45 @@ void Xcp_MemSet(void * dest, uint8_t fill_char, uint32_t len)
 
 //    ASSERT(dest != (void *)NULL);
 
+    if (len >= XCP_MEM_BULK_THRESHOLD) {
+        while (XCP_MEM_MISALIGNMENT(p) != UINT32(0)) {
+            *p++ = fill_char;
+            --len;
+        }
+#if defined(XCP_MEM_SSE2)
+        {
+            __m128i const v = _mm_set1_epi8((char)fill_char);
+
+            while (len >= XCP_MEM_VECTOR_SIZE) {
+                _mm_store_si128((__m128i *)p, v);
+                p += XCP_MEM_VECTOR_SIZE;
+                len -= XCP_MEM_VECTOR_SIZE;
+            }
+        }
+#elif defined(XCP_MEM_NEON)
+        {
+            uint8x16_t const v = vdupq_n_u8(fill_char);
+
+            while (len >= XCP_MEM_VECTOR_SIZE) {
+                vst1q_u8(p, v);
+                p += XCP_MEM_VECTOR_SIZE;
+                len -= XCP_MEM_VECTOR_SIZE;
+            }
+        }
+#else
+        {
+            /* 0x0101...01 * fill_char */
+            Xcp_MemWordValueType const pattern = (((Xcp_MemWordValueType)~(Xcp_MemWordValueType)0) / (Xcp_MemWordValueType)0xff) *
+                                                 (Xcp_MemWordValueType)fill_char;
+
+            while (len >= XCP_MEM_WORD_SIZE) {
+                *(Xcp_MemWordType *)p = pattern;
+                p += XCP_MEM_WORD_SIZE;
+                len -= XCP_MEM_WORD_SIZE;
+            }
+        }
+#endif // XCP_MEM_SSE2
+    }
     while (len--) {
         *p++ = fill_char;
     }
@@ -65,11 +194,184 @@ bool Xcp_MemCmp(void const * lhs, void const * rhs, uint32_t len)
     if (len == UINT32(0)) {
         return XCP_FALSE;
     }
+    if (len >= XCP_MEM_BULK_THRESHOLD) {
+#if defined(XCP_MEM_SSE2)
+        while (len >= XCP_MEM_VECTOR_SIZE) {
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const *)pl), _mm_loadu_si128((__m128i const *)pr))) != 0xffff) {
+                return XCP_FALSE;
+            }
+            pl += XCP_MEM_VECTOR_SIZE;
+            pr += XCP_MEM_VECTOR_SIZE;
+            len -= XCP_MEM_VECTOR_SIZE;
+        }
+#elif defined(XCP_MEM_NEON)
+        while (len >= XCP_MEM_VECTOR_SIZE) {
+            if (vminvq_u8(vceqq_u8(vld1q_u8(pl), vld1q_u8(pr))) != UINT8(0xff)) {
+                return XCP_FALSE;
+            }
+            pl += XCP_MEM_VECTOR_SIZE;
+            pr += XCP_MEM_VECTOR_SIZE;
+            len -= XCP_MEM_VECTOR_SIZE;
+        }
+#else
+        if (XCP_MEM_MISALIGNMENT(pl) == XCP_MEM_MISALIGNMENT(pr)) {
+            while (XCP_MEM_MISALIGNMENT(pl) != UINT32(0)) {
+                if (*pl++ != *pr++) {
+                    return XCP_FALSE;
+                }
+                --len;
+            }
+            while (len >= XCP_MEM_WORD_SIZE) {
+                if (*(Xcp_MemWordType const *)pl != *(Xcp_MemWordType const *)pr) {
+                    return XCP_FALSE;
+                }
+                pl += XCP_MEM_WORD_SIZE;
+                pr += XCP_MEM_WORD_SIZE;
+                len -= XCP_MEM_WORD_SIZE;
+            }
+        }
+#endif // XCP_MEM_SSE2
+        if (len == UINT32(0)) {
+            return XCP_TRUE;
+        }
+    }
     while ((*pl++ == *pr++) && (--len != UINT32(0))) {
     }
     return (bool)(len == UINT32(0));
 }
 
+/*
+**  For device memory / memory shared with other bus masters: every byte is
+**  accessed exactly once, in ascending order, accesses are never merged.
+*/
+void Xcp_MemCopyVolatile(void volatile * dst, void const volatile * src, uint32_t len)
+{
+    uint8_t volatile * pd = (uint8_t volatile *)dst;
+    uint8_t const volatile * ps = (uint8_t const volatile *)src;
+
+    while (len--) {
+        *pd++ = *ps++;
+    }
+}
+
+/*
+**  Device memory (s. XCP_MEMORY_REGION_DEVICE) is copied with
+**  Xcp_MemCopyVolatile(), everything else with Xcp_MemCopy().
+*/
+void Xcp_MemTransfer(void * dst, void const * src, uint32_t len, bool device)
+{
+    if (device) {
+        Xcp_MemCopyVolatile(dst, src, len);
+    } else {
+        Xcp_MemCopy(dst, (void *)src, len);
+    }
+}
+
+/*
+**  Read-modify-write of shared words: the naturally aligned word covering the
+**  modified bytes is updated with compare-and-swap, so concurrent writers of
+**  other bits in the same word never lose their updates. Without atomic
+**  primitives the caller has to provide mutual exclusion.
+*/
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define XCP_MEM_CAS8(ptr, old, desired)     (_InterlockedCompareExchange8((char volatile *)(ptr), (char)(desired), (char)(old)) == (char)(old))
+#define XCP_MEM_CAS16(ptr, old, desired)    (_InterlockedCompareExchange16((short volatile *)(ptr), (short)(desired), (short)(old)) == (short)(old))
+#define XCP_MEM_CAS32(ptr, old, desired)    (_InterlockedCompareExchange((long volatile *)(ptr), (long)(desired), (long)(old)) == (long)(old))
+#define XCP_MEM_CAS64(ptr, old, desired)    (_InterlockedCompareExchange64((__int64 volatile *)(ptr), (__int64)(desired), (__int64)(old)) == (__int64)(old))
+#define XCP_MEM_ATOMIC_WIDTH            (8)
+#elif defined(__GNUC__) || defined(__clang__)
+#define XCP_MEM_CAS8(ptr, old, desired)     __sync_bool_compare_and_swap((ptr), (old), (desired))
+#define XCP_MEM_CAS16(ptr, old, desired)    __sync_bool_compare_and_swap((ptr), (old), (desired))
+#define XCP_MEM_CAS32(ptr, old, desired)    __sync_bool_compare_and_swap((ptr), (old), (desired))
+#define XCP_MEM_CAS64(ptr, old, desired)    __sync_bool_compare_and_swap((ptr), (old), (desired))
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+#define XCP_MEM_ATOMIC_WIDTH            (8)
+#else
+#define XCP_MEM_ATOMIC_WIDTH            (4)
+#endif
+#else
+#define XCP_MEM_CAS8(ptr, old, desired)     ((*(ptr) = (desired)), XCP_TRUE)
+#define XCP_MEM_CAS16(ptr, old, desired)    ((*(ptr) = (desired)), XCP_TRUE)
+#define XCP_MEM_CAS32(ptr, old, desired)    ((*(ptr) = (desired)), XCP_TRUE)
+#define XCP_MEM_CAS64(ptr, old, desired)    ((*(ptr) = (desired)), XCP_TRUE)
+#define XCP_MEM_ATOMIC_WIDTH            (4)
+#endif
+
+#define XCP_MEM_MODIFY_WORD(type, cas, word, andMask, xorMask)                          \
+    do {                                                                                \
+        type volatile * const wp = (type volatile *)(word);                            \
+        type old;                                                                       \
+        type andValue;                                                                  \
+        type xorValue;                                                                  \
+        Xcp_MemCopy(&andValue, (andMask), UINT32(sizeof(type)));                        \
+        Xcp_MemCopy(&xorValue, (xorMask), UINT32(sizeof(type)));                        \
+        do {                                                                            \
+            old = *wp;                                                                  \
+        } while (!cas(wp, old, (type)((old & andValue) ^ xorValue)));                  \
+    } while (0)
+
+/*
+**  ptr[idx] = (ptr[idx] & andMask[idx]) ^ xorMask[idx] for idx in [0, len),
+**  len <= XCP_MEM_ATOMIC_WIDTH. Bytes with andMask 0xff / xorMask 0x00 are
+**  not written at all.
+*/
+void Xcp_MemModify(uint8_t * ptr, uint8_t const * andMask, uint8_t const * xorMask, uint8_t len)
+{
+    uint8_t wordAnd[XCP_MEM_ATOMIC_WIDTH];
+    uint8_t wordXor[XCP_MEM_ATOMIC_WIDTH];
+    uintptr_t first;
+    uintptr_t last;
+    uintptr_t base;
+    uint8_t width;
+    uint8_t idx;
+    uint8_t end;
+
+    idx = UINT8(0);
+    while (idx < len) {
+        if ((andMask[idx] == UINT8(0xff)) && (xorMask[idx] == UINT8(0x00))) {
+            ++idx;
+            continue;
+        }
+        /* Modified bytes up to the end of the enclosing widest atomic word. */
+        first = (uintptr_t)(ptr + idx);
+        end = idx;
+        for (last = first + UINT8(1); (UINT8(last - (uintptr_t)ptr) < len) && ((last % XCP_MEM_ATOMIC_WIDTH) != 0u); ++last) {
+            if ((andMask[last - (uintptr_t)ptr] != UINT8(0xff)) || (xorMask[last - (uintptr_t)ptr] != UINT8(0x00))) {
+                end = UINT8(last - (uintptr_t)ptr);
+            }
+        }
+        last = (uintptr_t)(ptr + end);
+        for (width = UINT8(1); (first / width) != (last / width); width <<= 1) {
+        }
+        base = first - (first % width);
+        Xcp_MemSet(wordAnd, UINT8(0xff), UINT32(width));
+        Xcp_MemSet(wordXor, UINT8(0x00), UINT32(width));
+        for (; idx <= end; ++idx) {
+            wordAnd[(uintptr_t)(ptr + idx) - base] = andMask[idx];
+            wordXor[(uintptr_t)(ptr + idx) - base] = xorMask[idx];
+        }
+        switch (width) {
+            case 1:
+                XCP_MEM_MODIFY_WORD(uint8_t, XCP_MEM_CAS8, base, wordAnd, wordXor);
+                break;
+            case 2:
+                XCP_MEM_MODIFY_WORD(uint16_t, XCP_MEM_CAS16, base, wordAnd, wordXor);
+                break;
+            case 4:
+                XCP_MEM_MODIFY_WORD(uint32_t, XCP_MEM_CAS32, base, wordAnd, wordXor);
+                break;
+#if XCP_MEM_ATOMIC_WIDTH == 8
+            case 8:
+                XCP_MEM_MODIFY_WORD(uint64_t, XCP_MEM_CAS64, base, wordAnd, wordXor);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+}
+
 #if XCP_BUILD_TYPE == XCP_DEBUG_BUILD
 void Xcp_Hexdump(uint8_t const * buf, uint16_t sz)
 {
@@ -39,8 +39,17 @@
 #define XCP_ENABLE_STIM                             XCP_OFF
 
 #define XCP_CHECKSUM_METHOD                         XCP_CHECKSUM_METHOD_XCP_ADD_44 // XCP_CHECKSUM_METHOD_XCP_CRC_16_CITT
+#define XCP_CHECKSUM_METHODS                        (0)     /* Additional methods, e.g. XCP_CHECKSUM_METHOD_MASK(XCP_CHECKSUM_METHOD_XCP_CRC_32) */
 #define XCP_CHECKSUM_CHUNKED_CALCULATION            XCP_ON
-#define XCP_CHECKSUM_CHUNK_SIZE                     (64)
+#define XCP_CHECKSUM_CHUNK_SIZE                     (64)    /* Initial resp. minimum chunk size. */
+#define XCP_CHECKSUM_MAIN_FUNCTION_TIME_BUDGET      (0)     /* Timer ticks, 0 ==> fixed chunk size */
+#define XCP_CHECKSUM_WORKER_THREAD                  XCP_OFF /* Linux only. */
+#define XCP_CHECKSUM_WORKER_THREADS                 (4)     /* Threads per checksum, incl. the worker. */
+#define XCP_CHECKSUM_PARALLEL_THRESHOLD             (0x00400000)    /* Bytes, smaller blocks use one thread. */
+#define XCP_CHECKSUM_INDEX_REGIONS                  (0)     /* 0 ==> no checksum index */
+#define XCP_CHECKSUM_INDEX_BLOCK_SIZE               (4096)
+#define XCP_CHECKSUM_INDEX_BLOCKS                   (256)   /* Cached block checksums for all regions. */
+#define XCP_CHECKSUM_INDEX_MAX_DIRTY                (16384) /* Bytes, more ==> background job. */
 #define XCP_CHECKSUM_MAXIMUM_BLOCK_SIZE             (0)     /* 0 ==> unlimited */
 
 #define XCP_BYTE_ORDER                              XCP_BYTE_ORDER_INTEL
@@ -64,6 +73,11 @@
 #define XCP_DAQ_ALTERNATING_SUPPORTED               XCP_OFF
 #define XCP_DAQ_CLOCK_ACCESS_ALWAYS_SUPPORTED       XCP_ON
 
+#define XCP_DAQ_QUEUE_SIZE                          (16)    /* Number of DTOs. */
+#define XCP_DAQ_MAIN_FUNCTION_BYTE_BUDGET           (0)     /* 0 ==> unlimited */
+#define XCP_DAQ_MAIN_FUNCTION_TIME_BUDGET           (0)     /* Timer ticks, 0 ==> unlimited */
+#define XCP_DAQ_PLAN_CACHE_SIZE                     (2)     /* Number of compiled configurations kept. */
+
 #define XCP_DAQ_MAX_EVENT_CHANNEL                   (3)
 #define XCP_DAQ_MULTIPLE_DAQ_LISTS_PER_EVENT_SUPPORTED  XCP_OFF
 
@@ -100,6 +114,10 @@
     #define XCP_ENABLE_SHORT_DOWNLOAD               XCP_ON
     #define XCP_ENABLE_MODIFY_BITS                  XCP_ON
 
+#define XCP_CAL_STAGING_SIZE                        (0)     /* Bytes per calibration transaction, 0 ==> writes are immediate */
+#define XCP_CAL_COMMIT_ON_EVENT                     XCP_ON  /* Apply committed transactions on XCP_CAL_COMMIT_EVENT */
+#define XCP_CAL_COMMIT_EVENT                        (0)
+
 #define XCP_ENABLE_PAG_COMMANDS                     XCP_OFF
 
     #define XCP_ENABLE_GET_PAG_PROCESSOR_INFO       XCP_OFF
@@ -109,6 +127,8 @@
     #define XCP_ENABLE_GET_SEGMENT_MODE             XCP_OFF
     #define XCP_ENABLE_COPY_CAL_PAGE                XCP_OFF
 
+#define XCP_PAG_SEGMENTS                            (1)
+
 #define XCP_ENABLE_DAQ_COMMANDS                     XCP_ON
 
     #define XCP_ENABLE_GET_DAQ_CLOCK                XCP_ON
@@ -154,9 +174,13 @@
 **  Customization Options.
 */
 #define XCP_ENABLE_ADDRESS_MAPPER                   XCP_ON
+#define XCP_ADDRESS_MAPPER_ENTRIES                  (8)
 #define XCP_ENABLE_CHECK_MEMORY_ACCESS              XCP_ON
+#define XCP_MEMORY_REGIONS                          (0)     /* Size of Xcp_MemoryRegions[], 0 ==> hook only */
 
 #define XCP_ENABLE_GET_ID_HOOK                      XCP_OFF
+#define XCP_ENABLE_BUILD_CHECKSUM_HOOK              XCP_OFF
+#define XCP_ENABLE_COPY_CAL_PAGE_HOOK               XCP_OFF
 
 #define XCP_DAQ_LIST_TYPE                           uint8_t
 #define XCP_DAQ_ODT_TYPE                            uint8_t